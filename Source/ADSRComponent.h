@@ -1,40 +1,40 @@
-/*
-  ==============================================================================
-
-    ADSRComponent.h
-    Created: 9 Jul 2024 4:18:47pm
-    Author:  tmobr
-
-  ==============================================================================
-*/
-
-#pragma once
-
-#include <JuceHeader.h>
-#include "PluginProcessor.h"
-
-//==============================================================================
-/*
-*/
-class ADSRComponent  : public juce::Component
-{
-public:
-    ADSRComponent(SimpleSamplerAudioProcessor& p);
-    ~ADSRComponent() override;
-
-    void paint (juce::Graphics&) override;
-    void resized() override;
-
-private:
-    juce::Slider attackSlider, decaySlider, sustainSlider, releaseSlider;
-    juce::Label attackLabel, decayLabel, sustainLabel, releaseLabel;
-
-    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> attackAttachment;
-    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> decayAttachment;
-    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> sustainAttachment;
-    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> releaseAttachment;
-
-    SimpleSamplerAudioProcessor& audioProcessor;
-
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ADSRComponent)
-};
+/*
+  ==============================================================================
+
+    ADSRComponent.h
+    Created: 9 Jul 2024 4:18:47pm
+    Author:  tmobr
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+
+//==============================================================================
+/*
+*/
+class ADSRComponent  : public juce::Component
+{
+public:
+    ADSRComponent(SimpleSamplerAudioProcessor& p);
+    ~ADSRComponent() override;
+
+    void paint (juce::Graphics&) override;
+    void resized() override;
+
+private:
+    juce::Slider attackSlider, decaySlider, sustainSlider, releaseSlider;
+    juce::Label attackLabel, decayLabel, sustainLabel, releaseLabel;
+
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> attackAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> decayAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> sustainAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> releaseAttachment;
+
+    SimpleSamplerAudioProcessor& audioProcessor;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ADSRComponent)
+};
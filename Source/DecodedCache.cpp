@@ -0,0 +1,135 @@
+/*
+  ==============================================================================
+
+    DecodedCache.cpp
+    Created: 17 Oct 2026 9:24:40pm
+    Author:  tmobr
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "DecodedCache.h"
+
+//==============================================================================
+DecodedCache::DecodedCache(const juce::File& directoryToUse)
+    : mDirectory(directoryToUse)
+{
+}
+
+juce::File DecodedCache::getDefaultDirectory() {
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+               .getChildFile(JucePlugin_Name)
+               .getChildFile("Decoded Cache");
+}
+
+juce::File DecodedCache::getDecodedFile(const juce::File& source, const juce::String& contentHash, juce::AudioFormatReader& reader,
+                                        const juce::Array<juce::File>& entriesInUse) {
+    if (auto entry = findDecodedFile(source, contentHash); entry != juce::File()) {
+        return entry;
+    }
+
+    auto entry = getEntryFile(source, contentHash);
+
+    if (!mDirectory.createDirectory() || !write(entry, reader)) {
+        return {};
+    }
+
+    evict(entry, entriesInUse);
+
+    return entry;
+}
+
+juce::File DecodedCache::findDecodedFile(const juce::File& source, const juce::String& contentHash) {
+    auto entry = getEntryFile(source, contentHash);
+
+    if (!entry.existsAsFile()) {
+        return {};
+    }
+
+    // Access times are what eviction goes by, and many file systems don't
+    // update them on reads.
+    entry.setLastAccessTime(juce::Time::getCurrentTime());
+    return entry;
+}
+
+juce::File DecodedCache::getEntryFile(const juce::File& source, const juce::String& contentHash) const {
+    const auto key = source.getFullPathName()
+                   + "|" + juce::String(source.getSize())
+                   + "|" + juce::String(source.getLastModificationTime().toMilliseconds())
+                   + "|" + contentHash;
+
+    return mDirectory.getChildFile(juce::MD5(key.toUTF8()).toHexString() + ".wav");
+}
+
+bool DecodedCache::write(const juce::File& entry, juce::AudioFormatReader& reader) const {
+    // Another instance may be caching the same file; whichever rename lands
+    // last wins, and both copies are identical. The partial file has its own
+    // extension so eviction never deletes one that's still being written.
+    const auto partialName = entry.getFileNameWithoutExtension() + "_" + juce::String::toHexString(juce::Random::getSystemRandom().nextInt64());
+    juce::TemporaryFile temp(entry, mDirectory.getChildFile(partialName + partialExtension));
+
+    {
+        auto stream = temp.getFile().createOutputStream();
+
+        if (stream == nullptr) {
+            return false;
+        }
+
+        juce::WavAudioFormat wav;
+        const auto numChannels = juce::jmin(2, static_cast<int>(reader.numChannels));
+        std::unique_ptr<juce::AudioFormatWriter> writer(wav.createWriterFor(stream.get(), reader.sampleRate, static_cast<unsigned int>(numChannels), 32, {}, 0));
+
+        if (writer == nullptr) {
+            return false;
+        }
+
+        stream.release();
+
+        if (!writer->writeFromAudioReader(reader, 0, -1)) {
+            return false;
+        }
+    }
+
+    return temp.overwriteTargetFileWithTemporary();
+}
+
+void DecodedCache::evict(const juce::File& entryToKeep, const juce::Array<juce::File>& entriesInUse) const {
+    // Partial files are only left behind by a crash once they're this old.
+    const auto abandoned = juce::Time::getCurrentTime() - juce::RelativeTime::days(1);
+
+    for (const auto& partial : mDirectory.findChildFiles(juce::File::findFiles, false, juce::String("*") + partialExtension)) {
+        if (partial.getLastModificationTime() < abandoned) {
+            partial.deleteFile();
+        }
+    }
+
+    auto entries = mDirectory.findChildFiles(juce::File::findFiles, false, "*.wav");
+    juce::int64 totalSize = 0;
+
+    for (const auto& entry : entries) {
+        totalSize += entry.getSize();
+    }
+
+    std::sort(entries.begin(), entries.end(), [] (const juce::File& a, const juce::File& b) {
+        return a.getLastAccessTime() < b.getLastAccessTime();
+    });
+
+    // A streaming voice closes its reader when idle and reopens the entry on
+    // its next note, so entries still loaded are never deleted, however old.
+    // An entry another process still has mapped may refuse to go; it's tried
+    // again next time.
+    for (const auto& entry : entries) {
+        if (totalSize <= mMaxSize) {
+            break;
+        }
+
+        if (entry != entryToKeep && !entriesInUse.contains(entry)) {
+            const auto size = entry.getSize();
+
+            if (entry.deleteFile()) {
+                totalSize -= size;
+            }
+        }
+    }
+}
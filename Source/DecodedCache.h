@@ -0,0 +1,56 @@
+/*
+  ==============================================================================
+
+    DecodedCache.h
+    Created: 17 Oct 2026 9:24:40pm
+    Author:  tmobr
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/*
+    Decoded copies of compressed files, kept on disk as 32-bit float WAVs so
+    the loader can memory-map them like any other uncompressed file. Entries
+    are keyed by the source's path, size, modification time and content hash,
+    so an edited file is simply decoded again.
+
+    The directory is shared by every plugin instance. Entries are written to a
+    temporary file and renamed into place, and the least recently used ones
+    are deleted once the directory grows past its size limit.
+*/
+class DecodedCache
+{
+public:
+    explicit DecodedCache(const juce::File& directoryToUse = getDefaultDirectory());
+
+    static juce::File getDefaultDirectory();
+
+    void setMaxSize(juce::int64 maxBytes) { mMaxSize = juce::jmax(static_cast<juce::int64>(0), maxBytes); }
+    juce::int64 getMaxSize() const { return mMaxSize; }
+
+    // Returns the cached copy of source, decoding it from reader first if it
+    // isn't cached yet. Returns an empty File if the copy couldn't be written.
+    // Making room never deletes the entries listed as in use.
+    juce::File getDecodedFile(const juce::File& source, const juce::String& contentHash, juce::AudioFormatReader& reader,
+                              const juce::Array<juce::File>& entriesInUse = {});
+
+    // Returns the cached copy only if there already is one.
+    juce::File findDecodedFile(const juce::File& source, const juce::String& contentHash);
+
+private:
+    juce::File getEntryFile(const juce::File& source, const juce::String& contentHash) const;
+    bool write(const juce::File& entry, juce::AudioFormatReader& reader) const;
+    void evict(const juce::File& entryToKeep, const juce::Array<juce::File>& entriesInUse) const;
+
+    static constexpr const char* partialExtension = ".partial";
+
+    juce::File mDirectory;
+    std::atomic<juce::int64> mMaxSize { static_cast<juce::int64>(4) << 30 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DecodedCache)
+};
@@ -0,0 +1,203 @@
+/*
+  ==============================================================================
+
+    DiskStreamer.cpp
+    Created: 17 Oct 2026 10:58:13am
+    Author:  tmobr
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "DiskStreamer.h"
+
+//==============================================================================
+DiskStreamer::DiskStreamer() : juce::TimeSliceThread("Disk Streamer")
+{
+    mFormatManager.registerBasicFormats();
+    startThread();
+}
+
+DiskStreamer::~DiskStreamer()
+{
+    stopThread(4000);
+}
+
+std::unique_ptr<juce::AudioFormatReader> DiskStreamer::createReaderFor(const juce::File& file) {
+    return std::unique_ptr<juce::AudioFormatReader>(mFormatManager.createReaderFor(file));
+}
+
+//==============================================================================
+StreamBuffer::StreamBuffer(DiskStreamer& streamer) : mStreamer(streamer), mRing(2, ringSize)
+{
+    mRing.clear();
+    mStreamer.addTimeSliceClient(this);
+}
+
+StreamBuffer::~StreamBuffer()
+{
+    mStreamer.removeTimeSliceClient(this);
+
+    // Release any references the streamer thread never got round to adopting.
+    takeRequests();
+}
+
+void StreamBuffer::start(SampleSound& sound, juce::int64 startFrame) {
+    mGeneration = (mGeneration + 1) & 0xffff;
+    mReadPosition.store(startFrame);
+    mFillState.store(pack(mGeneration, startFrame));
+
+    sound.incReferenceCount();
+    post({ &sound, startFrame, mGeneration });
+}
+
+void StreamBuffer::stop() {
+    mGeneration = (mGeneration + 1) & 0xffff;
+    mFillState.store(pack(mGeneration, 0));
+
+    post({ nullptr, 0, mGeneration });
+}
+
+void StreamBuffer::post(const Request& request) {
+    int start1, size1, start2, size2;
+    mRequestFifo.prepareToWrite(1, start1, size1, start2, size2);
+
+    if (size1 + size2 == 0) {
+        // The streamer thread is badly behind. The voice still holds the sound,
+        // so this can't be the last reference; the voice just plays its head.
+        if (request.sound != nullptr) {
+            request.sound->decReferenceCount();
+        }
+
+        return;
+    }
+
+    mRequests[static_cast<size_t>(size1 > 0 ? start1 : start2)] = request;
+    mRequestFifo.finishedWrite(1);
+}
+
+void StreamBuffer::beginBlock() noexcept {
+    auto state = mFillState.load(std::memory_order_acquire);
+
+    mBlockStart = mReadPosition.load(std::memory_order_relaxed);
+    mBlockEnd = generationOf(state) == mGeneration ? frameOf(state) : mBlockStart;
+}
+
+bool StreamBuffer::read(juce::int64 frame, float& left, float& right) noexcept {
+    if (frame < mBlockStart || frame >= mBlockEnd) {
+        mNumUnderruns.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    auto index = static_cast<int>(frame & ringMask);
+    left = mRing.getReadPointer(0)[index];
+    right = mRing.getReadPointer(1)[index];
+
+    return true;
+}
+
+void StreamBuffer::setReadPosition(juce::int64 frame) noexcept {
+    mReadPosition.store(juce::jmax(frame, mBlockStart), std::memory_order_release);
+}
+
+//==============================================================================
+int StreamBuffer::useTimeSlice() {
+    takeRequests();
+
+    if (mSound == nullptr) {
+        return 20;
+    }
+
+    if (!mStreamActive) {
+        // Keep the reader open for a while in case the voice replays the same sound.
+        if (juce::Time::getMillisecondCounter() - mIdleSince > 2000) {
+            mReader.reset();
+            mSound = nullptr;
+        }
+
+        return 20;
+    }
+
+    return fill();
+}
+
+bool StreamBuffer::takeRequests() {
+    int start1, size1, start2, size2;
+    mRequestFifo.prepareToRead(mRequestFifo.getNumReady(), start1, size1, start2, size2);
+
+    auto adopt = [this] (const Request& request) {
+        mStreamGeneration = request.generation;
+        mStreamActive = request.sound != nullptr;
+
+        if (!mStreamActive) {
+            mIdleSince = juce::Time::getMillisecondCounter();
+            return;
+        }
+
+        // Zones that share sample data can share the open reader too.
+        if (mSound == nullptr || &request.sound->getSampleData() != &mSound->getSampleData()) {
+            mReader.reset();
+        }
+
+        mSound = request.sound;
+
+        request.sound->decReferenceCount();
+    };
+
+    for (int i = 0; i < size1; ++i) {
+        adopt(mRequests[static_cast<size_t>(start1 + i)]);
+    }
+
+    for (int i = 0; i < size2; ++i) {
+        adopt(mRequests[static_cast<size_t>(start2 + i)]);
+    }
+
+    mRequestFifo.finishedRead(size1 + size2);
+
+    return size1 + size2 > 0;
+}
+
+int StreamBuffer::fill() {
+    if (mReader == nullptr) {
+        mReader = mStreamer.createReaderFor(mSound->getSampleData().getAudioFile());
+
+        if (mReader == nullptr) {
+            return 100;
+        }
+    }
+
+    auto state = mFillState.load(std::memory_order_acquire);
+
+    if (generationOf(state) != mStreamGeneration) {
+        // A newer request is already queued behind this one.
+        return 0;
+    }
+
+    // If the voice has overtaken the fill point, skip ahead to where it is now.
+    auto readPosition = mReadPosition.load(std::memory_order_acquire);
+    auto from = juce::jmax(frameOf(state), readPosition);
+
+    // Nothing from the read position on may be overwritten, and that includes
+    // the frames the voice's interpolator reaches back for.
+    auto numToRead = static_cast<int>(juce::jmin(static_cast<juce::int64>(readChunkSize),
+                                                 readPosition + ringSize - from,
+                                                 mSound->getLengthInSamples() - from));
+
+    if (numToRead <= 0) {
+        return 5;
+    }
+
+    auto slot = static_cast<int>(from & ringMask);
+    auto numBeforeWrap = juce::jmin(numToRead, ringSize - slot);
+
+    mReader->read(&mRing, slot, numBeforeWrap, from, true, true);
+
+    if (numToRead > numBeforeWrap) {
+        mReader->read(&mRing, 0, numToRead - numBeforeWrap, from + numBeforeWrap, true, true);
+    }
+
+    // Fails harmlessly if the voice started another note while we were reading.
+    mFillState.compare_exchange_strong(state, pack(mStreamGeneration, from + numToRead), std::memory_order_acq_rel);
+
+    return 0;
+}
@@ -0,0 +1,108 @@
+/*
+  ==============================================================================
+
+    DiskStreamer.h
+    Created: 17 Oct 2026 10:58:13am
+    Author:  tmobr
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "SampleSound.h"
+
+//==============================================================================
+/*
+    The background thread that feeds every streaming voice. Each voice owns a
+    StreamBuffer that registers itself here.
+*/
+class DiskStreamer  : public juce::TimeSliceThread
+{
+public:
+    DiskStreamer();
+    ~DiskStreamer() override;
+
+    std::unique_ptr<juce::AudioFormatReader> createReaderFor(const juce::File& file);
+
+private:
+    juce::AudioFormatManager mFormatManager;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DiskStreamer)
+};
+
+//==============================================================================
+/*
+    A per-voice ring buffer holding the part of a sound that follows its
+    preloaded head. The audio thread starts and stops streams and reads frames;
+    the streamer thread opens readers and fills the ring ahead of the voice.
+
+    Frames are addressed by their absolute position in the file, so there is no
+    limit on sample length other than the 48 bits used to publish positions.
+*/
+class StreamBuffer  : public juce::TimeSliceClient
+{
+public:
+    explicit StreamBuffer(DiskStreamer& streamer);
+    ~StreamBuffer() override;
+
+    // Audio thread only.
+    void start(SampleSound& sound, juce::int64 startFrame);
+    void stop();
+    void beginBlock() noexcept;
+    bool read(juce::int64 frame, float& left, float& right) noexcept;
+
+    // The earliest frame the voice can still read, history for its
+    // interpolator included. Frames from here on stay in the ring.
+    void setReadPosition(juce::int64 frame) noexcept;
+
+    int getNumUnderruns() const noexcept { return mNumUnderruns.load(); }
+
+    int useTimeSlice() override;
+
+private:
+    struct Request
+    {
+        SampleSound* sound = nullptr;   // carries one reference, adopted by the streamer thread
+        juce::int64 startFrame = 0;
+        juce::uint64 generation = 0;
+    };
+
+    static constexpr int ringSize = 1 << 14;
+    static constexpr int ringMask = ringSize - 1;
+    static constexpr int readChunkSize = 4096;
+    static constexpr juce::uint64 positionMask = (juce::uint64(1) << 48) - 1;
+
+    static juce::uint64 pack(juce::uint64 generation, juce::int64 frame) noexcept { return (generation << 48) | (juce::uint64(frame) & positionMask); }
+    static juce::uint64 generationOf(juce::uint64 state) noexcept { return state >> 48; }
+    static juce::int64 frameOf(juce::uint64 state) noexcept { return juce::int64(state & positionMask); }
+
+    void post(const Request& request);
+    bool takeRequests();
+    int fill();
+
+    DiskStreamer& mStreamer;
+    juce::AudioBuffer<float> mRing;
+
+    juce::AbstractFifo mRequestFifo{ 16 };
+    std::array<Request, 16> mRequests;
+
+    // Generation in the top 16 bits, end of the valid range in the rest.
+    std::atomic<juce::uint64> mFillState{ 0 };
+    std::atomic<juce::int64> mReadPosition{ 0 };
+    std::atomic<int> mNumUnderruns{ 0 };
+
+    // Audio thread state.
+    juce::uint64 mGeneration = 0;
+    juce::int64 mBlockStart = 0, mBlockEnd = 0;
+
+    // Streamer thread state.
+    SampleSound::Ptr mSound;
+    std::unique_ptr<juce::AudioFormatReader> mReader;
+    juce::uint64 mStreamGeneration = 0;
+    bool mStreamActive = false;
+    juce::uint32 mIdleSince = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (StreamBuffer)
+};
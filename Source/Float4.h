@@ -0,0 +1,131 @@
+/*
+  ==============================================================================
+
+    Float4.h
+    Created: 17 Oct 2026 4:02:51pm
+    Author:  tmobr
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <cstdint>
+
+#if defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2)
+ #include <emmintrin.h>
+ #define SAMPLER_FLOAT4_SSE 1
+#elif defined (__ARM_NEON) || defined (__ARM_NEON__) || defined (_M_ARM64)
+ #include <arm_neon.h>
+ #define SAMPLER_FLOAT4_NEON 1
+#endif
+
+//==============================================================================
+/*
+    Four floats processed together: one lane per voice in the voice bank.
+    Maps onto SSE2 or NEON where available and plain arrays elsewhere.
+*/
+struct Float4
+{
+   #if SAMPLER_FLOAT4_SSE
+    __m128 v;
+
+    static Float4 load(const float* p) noexcept                     { return { _mm_loadu_ps(p) }; }
+    void store(float* p) const noexcept                              { _mm_storeu_ps(p, v); }
+    static Float4 set(float a, float b, float c, float d) noexcept    { return { _mm_setr_ps(a, b, c, d) }; }
+    static Float4 broadcast(float x) noexcept                        { return { _mm_set1_ps(x) }; }
+
+    // Sign-extends through the top half of each 32-bit lane.
+    static Float4 fromInt16(const std::int16_t* p) noexcept
+    {
+        auto x = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(p));
+        return { _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16)) };
+    }
+
+    static Float4 fromInt32(const std::int32_t* p) noexcept         { return { _mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))) }; }
+
+    friend Float4 operator+ (Float4 a, Float4 b) noexcept            { return { _mm_add_ps(a.v, b.v) }; }
+    friend Float4 operator- (Float4 a, Float4 b) noexcept            { return { _mm_sub_ps(a.v, b.v) }; }
+    friend Float4 operator* (Float4 a, Float4 b) noexcept            { return { _mm_mul_ps(a.v, b.v) }; }
+    static Float4 min(Float4 a, Float4 b) noexcept                   { return { _mm_min_ps(a.v, b.v) }; }
+    static Float4 max(Float4 a, Float4 b) noexcept                   { return { _mm_max_ps(a.v, b.v) }; }
+
+    // Splits non-negative values into integer and fractional parts.
+    Float4 split(int* integers) const noexcept
+    {
+        auto i = _mm_cvttps_epi32(v);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(integers), i);
+        return { _mm_sub_ps(v, _mm_cvtepi32_ps(i)) };
+    }
+
+    float sum() const noexcept
+    {
+        auto pairs = _mm_add_ps(v, _mm_movehl_ps(v, v));
+        return _mm_cvtss_f32(_mm_add_ss(pairs, _mm_shuffle_ps(pairs, pairs, 1)));
+    }
+   #elif SAMPLER_FLOAT4_NEON
+    float32x4_t v;
+
+    static Float4 load(const float* p) noexcept                     { return { vld1q_f32(p) }; }
+    void store(float* p) const noexcept                              { vst1q_f32(p, v); }
+    static Float4 set(float a, float b, float c, float d) noexcept    { const float x[4] = { a, b, c, d }; return load(x); }
+    static Float4 broadcast(float x) noexcept                        { return { vdupq_n_f32(x) }; }
+    static Float4 fromInt16(const std::int16_t* p) noexcept         { return { vcvtq_f32_s32(vmovl_s16(vld1_s16(p))) }; }
+    static Float4 fromInt32(const std::int32_t* p) noexcept         { return { vcvtq_f32_s32(vld1q_s32(p)) }; }
+
+    friend Float4 operator+ (Float4 a, Float4 b) noexcept            { return { vaddq_f32(a.v, b.v) }; }
+    friend Float4 operator- (Float4 a, Float4 b) noexcept            { return { vsubq_f32(a.v, b.v) }; }
+    friend Float4 operator* (Float4 a, Float4 b) noexcept            { return { vmulq_f32(a.v, b.v) }; }
+    static Float4 min(Float4 a, Float4 b) noexcept                   { return { vminq_f32(a.v, b.v) }; }
+    static Float4 max(Float4 a, Float4 b) noexcept                   { return { vmaxq_f32(a.v, b.v) }; }
+
+    Float4 split(int* integers) const noexcept
+    {
+        auto i = vcvtq_s32_f32(v);
+        vst1q_s32(integers, i);
+        return { vsubq_f32(v, vcvtq_f32_s32(i)) };
+    }
+
+    float sum() const noexcept
+    {
+        auto pairs = vadd_f32(vget_low_f32(v), vget_high_f32(v));
+        return vget_lane_f32(vpadd_f32(pairs, pairs), 0);
+    }
+   #else
+    float v[4];
+
+    static Float4 load(const float* p) noexcept                     { return { { p[0], p[1], p[2], p[3] } }; }
+    void store(float* p) const noexcept                              { for (int i = 0; i < 4; ++i) p[i] = v[i]; }
+    static Float4 set(float a, float b, float c, float d) noexcept    { return { { a, b, c, d } }; }
+    static Float4 broadcast(float x) noexcept                        { return { { x, x, x, x } }; }
+
+    template <typename Integer>
+    static Float4 fromIntegers(const Integer* p) noexcept            { return { { static_cast<float>(p[0]), static_cast<float>(p[1]), static_cast<float>(p[2]), static_cast<float>(p[3]) } }; }
+
+    static Float4 fromInt16(const std::int16_t* p) noexcept         { return fromIntegers(p); }
+    static Float4 fromInt32(const std::int32_t* p) noexcept         { return fromIntegers(p); }
+
+    template <typename Op>
+    static Float4 apply(Float4 a, Float4 b, Op op) noexcept          { return { { op(a.v[0], b.v[0]), op(a.v[1], b.v[1]), op(a.v[2], b.v[2]), op(a.v[3], b.v[3]) } }; }
+
+    friend Float4 operator+ (Float4 a, Float4 b) noexcept            { return apply(a, b, [] (float x, float y) { return x + y; }); }
+    friend Float4 operator- (Float4 a, Float4 b) noexcept            { return apply(a, b, [] (float x, float y) { return x - y; }); }
+    friend Float4 operator* (Float4 a, Float4 b) noexcept            { return apply(a, b, [] (float x, float y) { return x * y; }); }
+    static Float4 min(Float4 a, Float4 b) noexcept                   { return apply(a, b, [] (float x, float y) { return x < y ? x : y; }); }
+    static Float4 max(Float4 a, Float4 b) noexcept                   { return apply(a, b, [] (float x, float y) { return x > y ? x : y; }); }
+
+    Float4 split(int* integers) const noexcept
+    {
+        Float4 fraction;
+
+        for (int i = 0; i < 4; ++i) {
+            integers[i] = static_cast<int>(v[i]);
+            fraction.v[i] = v[i] - static_cast<float>(integers[i]);
+        }
+
+        return fraction;
+    }
+
+    float sum() const noexcept { return (v[0] + v[1]) + (v[2] + v[3]); }
+   #endif
+};
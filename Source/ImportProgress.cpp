@@ -0,0 +1,52 @@
+/*
+  ==============================================================================
+
+    ImportProgress.cpp
+    Created: 17 Oct 2026 10:28:03pm
+    Author:  tmobr
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "ImportProgress.h"
+
+//==============================================================================
+ImportProgress::ImportProgress(SimpleSamplerAudioProcessor& p) : audioProcessor(p)
+{
+    addAndMakeVisible(mProgressBar);
+    addAndMakeVisible(mCancelButton);
+
+    mCancelButton.onClick = [this] {
+        if (audioProcessor.isExporting()) {
+            audioProcessor.cancelExport();
+        }
+        else {
+            audioProcessor.cancelLoading();
+        }
+    };
+
+    setVisible(false);
+    startTimerHz(10);
+}
+
+ImportProgress::~ImportProgress()
+{
+}
+
+void ImportProgress::resized()
+{
+    auto bounds = getLocalBounds();
+
+    mCancelButton.setBounds(bounds.removeFromRight(70));
+    bounds.removeFromRight(6);
+    mProgressBar.setBounds(bounds);
+}
+
+void ImportProgress::timerCallback() {
+    // The bar repaints itself from mProgress on its own timer.
+    const auto exporting = audioProcessor.isExporting();
+
+    mProgress = exporting ? audioProcessor.getExportProgress() : audioProcessor.getLoadProgress();
+    setVisible(exporting || audioProcessor.isLoading());
+}
@@ -0,0 +1,40 @@
+/*
+  ==============================================================================
+
+    ImportProgress.h
+    Created: 17 Oct 2026 10:28:03pm
+    Author:  tmobr
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+
+//==============================================================================
+/*
+    A progress bar and cancel button for the loader and for kit exports, shown
+    only while one of them is busy. An export takes the bar while it runs.
+*/
+class ImportProgress  : public juce::Component,
+                        private juce::Timer
+{
+public:
+    ImportProgress(SimpleSamplerAudioProcessor& p);
+    ~ImportProgress() override;
+
+    void resized() override;
+
+private:
+    void timerCallback() override;
+
+    SimpleSamplerAudioProcessor& audioProcessor;
+
+    double mProgress = 0.0;
+    juce::ProgressBar mProgressBar{ mProgress };
+    juce::TextButton mCancelButton{ "Cancel" };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ImportProgress)
+};
@@ -0,0 +1,49 @@
+/*
+  ==============================================================================
+
+    LoadMeter.cpp
+    Created: 17 Oct 2026 8:10:03pm
+    Author:  tmobr
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "LoadMeter.h"
+
+//==============================================================================
+LoadMeter::LoadMeter(SimpleSamplerAudioProcessor& p) : audioProcessor(p)
+{
+    setOpaque(true);
+    startTimerHz(5);
+}
+
+LoadMeter::~LoadMeter()
+{
+}
+
+void LoadMeter::paint (juce::Graphics& g)
+{
+    g.fillAll(juce::Colours::black);
+
+    g.setColour(mOverloaded ? juce::Colours::red : juce::Colours::white.withAlpha(0.7f));
+    g.setFont(12.0f);
+    g.drawFittedText(mText, getLocalBounds(), juce::Justification::centredRight, 1);
+}
+
+void LoadMeter::timerCallback() {
+    const auto snapshot = audioProcessor.getLoadMonitor().getSnapshot();
+
+    auto text = "DSP " + juce::String(juce::roundToInt(snapshot.load * 100.0f)) + "%"
+              + "  peak " + juce::String(juce::roundToInt(snapshot.peakLoad * 100.0f)) + "%"
+              + "  voices " + juce::String(snapshot.numActiveVoices)
+              + "  overruns " + juce::String(snapshot.numOverruns);
+
+    const auto overloaded = snapshot.peakLoad > 0.9f;
+
+    if (text != mText || overloaded != mOverloaded) {
+        mText = text;
+        mOverloaded = overloaded;
+        repaint();
+    }
+}
@@ -0,0 +1,40 @@
+/*
+  ==============================================================================
+
+    LoadMeter.h
+    Created: 17 Oct 2026 8:10:03pm
+    Author:  tmobr
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+
+//==============================================================================
+/*
+    A one-line readout of the processor's DSP load, peak load, active voices
+    and overruns. Polls a few times a second and only repaints when the text
+    changes.
+*/
+class LoadMeter  : public juce::Component,
+                   private juce::Timer
+{
+public:
+    LoadMeter(SimpleSamplerAudioProcessor& p);
+    ~LoadMeter() override;
+
+    void paint (juce::Graphics&) override;
+
+private:
+    void timerCallback() override;
+
+    SimpleSamplerAudioProcessor& audioProcessor;
+
+    juce::String mText;
+    bool mOverloaded = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LoadMeter)
+};
@@ -0,0 +1,67 @@
+/*
+  ==============================================================================
+
+    LoadMonitor.cpp
+    Created: 17 Oct 2026 7:52:26pm
+    Author:  tmobr
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "LoadMonitor.h"
+
+//==============================================================================
+LoadMonitor::LoadMonitor()
+{
+}
+
+void LoadMonitor::prepare(double sampleRate) {
+    mSampleRate = sampleRate;
+    mWindowPeak = mPreviousWindowPeak = 0.0f;
+    mSamplesInWindow = 0;
+
+    mBlockMicroseconds = 0.0;
+    mLoad = 0.0f;
+    mPeakLoad = 0.0f;
+    mNumActiveVoices = 0;
+}
+
+void LoadMonitor::blockFinished(juce::int64 elapsedTicks, int numSamples, int numActiveVoices) noexcept {
+    if (numSamples <= 0) {
+        return;
+    }
+
+    const auto seconds = static_cast<double>(elapsedTicks) * mSecondsPerTick;
+    const auto load = static_cast<float>(seconds * mSampleRate / numSamples);
+
+    mWindowPeak = juce::jmax(mWindowPeak, load);
+    mSamplesInWindow += numSamples;
+
+    if (mSamplesInWindow >= static_cast<int>(mSampleRate)) {
+        mPreviousWindowPeak = mWindowPeak;
+        mWindowPeak = 0.0f;
+        mSamplesInWindow = 0;
+    }
+
+    if (load > 1.0f) {
+        mNumOverruns.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    mBlockMicroseconds.store(seconds * 1.0e6, std::memory_order_relaxed);
+    mLoad.store(load, std::memory_order_relaxed);
+    mPeakLoad.store(juce::jmax(mWindowPeak, mPreviousWindowPeak), std::memory_order_relaxed);
+    mNumActiveVoices.store(numActiveVoices, std::memory_order_relaxed);
+}
+
+LoadMonitor::Snapshot LoadMonitor::getSnapshot() const noexcept {
+    Snapshot snapshot;
+
+    snapshot.blockMicroseconds = mBlockMicroseconds.load(std::memory_order_relaxed);
+    snapshot.load = mLoad.load(std::memory_order_relaxed);
+    snapshot.peakLoad = mPeakLoad.load(std::memory_order_relaxed);
+    snapshot.numActiveVoices = mNumActiveVoices.load(std::memory_order_relaxed);
+    snapshot.numOverruns = mNumOverruns.load(std::memory_order_relaxed);
+
+    return snapshot;
+}
@@ -0,0 +1,80 @@
+/*
+  ==============================================================================
+
+    LoadMonitor.h
+    Created: 17 Oct 2026 7:52:26pm
+    Author:  tmobr
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/*
+    Times every processBlock and publishes the results through atomics, so the
+    editor or a host-side logger can read them from any thread without locks.
+
+    Load is the block's processing time as a share of the audio it produced;
+    anything above 1 would have missed its deadline and is counted as an
+    overrun. The peak is the highest load over roughly the last second.
+*/
+class LoadMonitor
+{
+public:
+    struct Snapshot
+    {
+        double blockMicroseconds = 0.0;
+        float load = 0.0f;
+        float peakLoad = 0.0f;
+        int numActiveVoices = 0;
+        int numOverruns = 0;
+    };
+
+    LoadMonitor();
+
+    void prepare(double sampleRate);
+
+    // Audio thread. Measures from construction to destruction.
+    class ScopedTimer
+    {
+    public:
+        ScopedTimer(LoadMonitor& monitorToUse, int numSamplesInBlock) noexcept
+            : monitor(monitorToUse), numSamples(numSamplesInBlock), start(juce::Time::getHighResolutionTicks()) {}
+
+        ~ScopedTimer() { monitor.blockFinished(juce::Time::getHighResolutionTicks() - start, numSamples, numActiveVoices); }
+
+        void setNumActiveVoices(int numVoices) noexcept { numActiveVoices = numVoices; }
+
+    private:
+        LoadMonitor& monitor;
+        int numSamples;
+        juce::int64 start;
+        int numActiveVoices = 0;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedTimer)
+    };
+
+    // Any thread.
+    Snapshot getSnapshot() const noexcept;
+    void resetOverruns() noexcept { mNumOverruns = 0; }
+
+private:
+    void blockFinished(juce::int64 elapsedTicks, int numSamples, int numActiveVoices) noexcept;
+
+    double mSampleRate = 44100.0;
+    double mSecondsPerTick = juce::Time::highResolutionTicksToSeconds(1);
+
+    // Audio thread only. The peak is taken over two alternating windows so it
+    // always covers between one and two window lengths.
+    float mWindowPeak = 0.0f, mPreviousWindowPeak = 0.0f;
+    int mSamplesInWindow = 0;
+
+    std::atomic<double> mBlockMicroseconds { 0.0 };
+    std::atomic<float> mLoad { 0.0f }, mPeakLoad { 0.0f };
+    std::atomic<int> mNumActiveVoices { 0 }, mNumOverruns { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LoadMonitor)
+};
@@ -0,0 +1,176 @@
+/*
+  ==============================================================================
+
+    OfflineRenderer.cpp
+    Created: 17 Oct 2026 7:05:12pm
+    Author:  tmobr
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "OfflineRenderer.h"
+
+//==============================================================================
+OfflineRenderer::OfflineRenderer(SimpleSamplerAudioProcessor& processorToDrive) : mProcessor(processorToDrive)
+{
+}
+
+bool OfflineRenderer::loadSample(const juce::File& file, int timeoutMilliseconds) {
+    const auto previous = mProcessor.getLoadedSample();
+    const auto deadline = juce::Time::getMillisecondCounter() + static_cast<juce::uint32>(timeoutMilliseconds);
+
+    mProcessor.loadFile(file.getFullPathName());
+
+    while (juce::Time::getMillisecondCounter() < deadline) {
+        auto loaded = mProcessor.getLoadedSample();
+
+        if (loaded != nullptr && loaded != previous) {
+            return true;
+        }
+
+        juce::Thread::sleep(5);
+    }
+
+    return false;
+}
+
+void OfflineRenderer::setParameter(const juce::String& parameterID, float value) {
+    if (auto* parameter = mProcessor.getAPVTS().getParameter(parameterID)) {
+        parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+    }
+}
+
+OfflineRenderer::Result OfflineRenderer::render(const juce::MidiMessageSequence& sequence, const Settings& settings) {
+    Result result;
+
+    setParameter("POLYPHONY", static_cast<float>(settings.polyphony));
+    setParameter("QUALITY", static_cast<float>(settings.quality));
+    mProcessor.setNumRenderThreads(settings.renderThreads);
+
+    mProcessor.setPlayConfigDetails(0, 2, settings.sampleRate, settings.blockSize);
+    mProcessor.prepareToPlay(settings.sampleRate, settings.blockSize);
+
+    std::unique_ptr<juce::AudioFormatWriter> writer;
+
+    if (settings.outputFile != juce::File()) {
+        settings.outputFile.deleteFile();
+
+        if (auto stream = settings.outputFile.createOutputStream()) {
+            juce::WavAudioFormat wav;
+            writer.reset(wav.createWriterFor(stream.get(), settings.sampleRate, 2, 24, {}, 0));
+
+            if (writer != nullptr) {
+                stream.release(); // the writer owns it now
+            }
+        }
+    }
+
+    const auto totalSamples = static_cast<juce::int64>((sequence.getEndTime() + settings.tailSeconds) * settings.sampleRate);
+
+    juce::AudioBuffer<float> buffer(2, settings.blockSize);
+    juce::MidiBuffer midi;
+    int nextEvent = 0;
+
+    // Reserved up front so recording a block's time never allocates mid-render.
+    std::vector<juce::int64> blockTicks;
+    blockTicks.reserve(static_cast<size_t>((totalSamples + settings.blockSize - 1) / settings.blockSize));
+
+    for (juce::int64 position = 0; position < totalSamples; position += settings.blockSize) {
+        const auto blockEnd = position + settings.blockSize;
+
+        midi.clear();
+
+        while (nextEvent < sequence.getNumEvents()) {
+            const auto& message = sequence.getEventPointer(nextEvent)->message;
+            const auto sample = static_cast<juce::int64>(message.getTimeStamp() * settings.sampleRate);
+
+            if (sample >= blockEnd) {
+                break;
+            }
+
+            midi.addEvent(message, static_cast<int>(juce::jmax(static_cast<juce::int64>(0), sample - position)));
+            ++nextEvent;
+        }
+
+        buffer.clear();
+
+        const auto start = juce::Time::getHighResolutionTicks();
+        mProcessor.processBlock(buffer, midi);
+        const auto elapsed = juce::Time::getHighResolutionTicks() - start;
+
+        blockTicks.push_back(elapsed);
+        ++result.numBlocks;
+
+        if (writer != nullptr) {
+            writer->writeFromAudioSampleBuffer(buffer, 0, settings.blockSize);
+        }
+    }
+
+    mProcessor.releaseResources();
+
+    const auto totalTicks = std::accumulate(blockTicks.begin(), blockTicks.end(), static_cast<juce::int64>(0));
+    const auto totalSeconds = juce::Time::highResolutionTicksToSeconds(totalTicks);
+
+    result.audioSeconds = static_cast<double>(result.numBlocks) * settings.blockSize / settings.sampleRate;
+    result.wroteOutput = writer != nullptr;
+
+    if (result.numBlocks > 0) {
+        std::sort(blockTicks.begin(), blockTicks.end());
+
+        result.meanNanosPerBlock = totalSeconds * 1.0e9 / result.numBlocks;
+        result.medianNanosPerBlock = juce::Time::highResolutionTicksToSeconds(blockTicks[blockTicks.size() / 2]) * 1.0e9;
+        result.bestNanosPerBlock = juce::Time::highResolutionTicksToSeconds(blockTicks.front()) * 1.0e9;
+        result.worstNanosPerBlock = juce::Time::highResolutionTicksToSeconds(blockTicks.back()) * 1.0e9;
+    }
+
+    if (totalSeconds > 0.0) {
+        result.realtimeFactor = result.audioSeconds / totalSeconds;
+    }
+
+    return result;
+}
+
+//==============================================================================
+juce::MidiMessageSequence OfflineRenderer::readMidiFile(const juce::File& file) {
+    juce::MidiMessageSequence result;
+    juce::MidiFile midiFile;
+    juce::FileInputStream stream(file);
+
+    if (!stream.openedOk() || !midiFile.readFrom(stream)) {
+        return result;
+    }
+
+    midiFile.convertTimestampTicksToSeconds();
+
+    for (int track = 0; track < midiFile.getNumTracks(); ++track) {
+        result.addSequence(*midiFile.getTrack(track), 0.0);
+    }
+
+    result.updateMatchedPairs();
+
+    return result;
+}
+
+juce::MidiMessageSequence OfflineRenderer::createNotePattern(double lengthSeconds, double notesPerSecond, double noteLengthSeconds, int seed) {
+    juce::MidiMessageSequence result;
+    juce::Random random(seed);
+
+    const auto numNotes = static_cast<int>(lengthSeconds * notesPerSecond);
+
+    // Spread over the keyboard and the velocity range so pitch ratios and
+    // layers vary the way they would in a real part.
+    for (int i = 0; i < numNotes; ++i) {
+        const auto time = i / notesPerSecond;
+        const auto note = 36 + random.nextInt(61);
+        const auto velocity = static_cast<juce::uint8>(32 + random.nextInt(96));
+
+        result.addEvent(juce::MidiMessage::noteOn(1, note, velocity), time);
+        result.addEvent(juce::MidiMessage::noteOff(1, note), time + noteLengthSeconds);
+    }
+
+    result.sort();
+    result.updateMatchedPairs();
+
+    return result;
+}
@@ -0,0 +1,68 @@
+/*
+  ==============================================================================
+
+    OfflineRenderer.h
+    Created: 17 Oct 2026 7:05:12pm
+    Author:  tmobr
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+
+//==============================================================================
+/*
+    Drives a processor without a host: feeds a MIDI sequence through
+    processBlock as fast as it will go, times every block, and optionally
+    writes what it rendered to a WAV file.
+
+    Blocks are rendered in realtime mode, so the timings are those of the
+    code path a host would run live.
+*/
+class OfflineRenderer
+{
+public:
+    struct Settings
+    {
+        double sampleRate = 48000.0;
+        int blockSize = 512;
+        int polyphony = 64;
+        int renderThreads = 0;          // workers helping the rendering thread
+        ResamplingQuality quality = ResamplingQuality::cubic;
+        double tailSeconds = 2.0;       // rendered after the last MIDI event
+        juce::File outputFile;          // nothing is written if this is empty
+    };
+
+    struct Result
+    {
+        int numBlocks = 0;
+        double audioSeconds = 0.0;
+        double meanNanosPerBlock = 0.0;
+        double medianNanosPerBlock = 0.0;
+        double bestNanosPerBlock = 0.0;
+        double worstNanosPerBlock = 0.0;
+        double realtimeFactor = 0.0;    // audio time over processing time
+        bool wroteOutput = false;
+    };
+
+    explicit OfflineRenderer(SimpleSamplerAudioProcessor& processorToDrive);
+
+    // Starts the usual asynchronous load and waits for the loader to finish.
+    bool loadSample(const juce::File& file, int timeoutMilliseconds = 30000);
+
+    Result render(const juce::MidiMessageSequence& sequence, const Settings& settings);
+
+    // Time stamps in the returned sequences are in seconds.
+    static juce::MidiMessageSequence readMidiFile(const juce::File& file);
+    static juce::MidiMessageSequence createNotePattern(double lengthSeconds, double notesPerSecond, double noteLengthSeconds, int seed = 1);
+
+private:
+    void setParameter(const juce::String& parameterID, float value);
+
+    SimpleSamplerAudioProcessor& mProcessor;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OfflineRenderer)
+};
@@ -0,0 +1,217 @@
+/*
+  ==============================================================================
+
+    PeakPyramid.cpp
+    Created: 17 Oct 2026 1:05:39pm
+    Author:  tmobr
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "PeakPyramid.h"
+
+//==============================================================================
+PeakPyramid::PeakPyramid()
+{
+}
+
+void PeakPyramid::reset(juce::int64 totalNumSamples) {
+    numSamples = totalNumSamples;
+    binSize = minBinSize;
+
+    while (numSamples / binSize > maxLevelZeroBins) {
+        binSize *= 2;
+    }
+
+    levels.clear();
+    levels.emplace_back();
+    levels.front().reserve(static_cast<size_t>((numSamples + binSize - 1) / binSize));
+
+    binMin = std::numeric_limits<float>::max();
+    binMax = std::numeric_limits<float>::lowest();
+    binSumOfSquares = 0.0;
+    binCount = 0;
+    binValues = 0;
+}
+
+void PeakPyramid::addSamples(const float* const* channels, int numChannels, int numSamplesToAdd) {
+    int offset = 0;
+
+    while (offset < numSamplesToAdd) {
+        auto numThisBin = juce::jmin(numSamplesToAdd - offset, binSize - binCount);
+
+        for (int channel = 0; channel < numChannels; ++channel) {
+            auto* data = channels[channel] + offset;
+            auto range = juce::FloatVectorOperations::findMinAndMax(data, numThisBin);
+
+            binMin = juce::jmin(binMin, range.getStart());
+            binMax = juce::jmax(binMax, range.getEnd());
+
+            for (int i = 0; i < numThisBin; ++i) {
+                binSumOfSquares += data[i] * data[i];
+            }
+        }
+
+        binCount += numThisBin;
+        binValues += numThisBin * numChannels;
+        offset += numThisBin;
+
+        if (binCount == binSize) {
+            flushBin();
+        }
+    }
+}
+
+void PeakPyramid::flushBin() {
+    Peak peak;
+    peak.min = binMin;
+    peak.max = binMax;
+    peak.rms = binValues > 0 ? static_cast<float>(std::sqrt(binSumOfSquares / binValues)) : 0.0f;
+
+    levels.front().push_back(peak);
+
+    binMin = std::numeric_limits<float>::max();
+    binMax = std::numeric_limits<float>::lowest();
+    binSumOfSquares = 0.0;
+    binCount = 0;
+    binValues = 0;
+}
+
+void PeakPyramid::finish() {
+    if (binCount > 0) {
+        flushBin();
+    }
+
+    while (levels.back().size() > 1) {
+        const auto& below = levels.back();
+        std::vector<Peak> level((below.size() + 1) / 2);
+
+        for (size_t i = 0; i < level.size(); ++i) {
+            const auto& a = below[i * 2];
+            const auto& b = i * 2 + 1 < below.size() ? below[i * 2 + 1] : a;
+
+            level[i].min = juce::jmin(a.min, b.min);
+            level[i].max = juce::jmax(a.max, b.max);
+            level[i].rms = std::sqrt((a.rms * a.rms + b.rms * b.rms) * 0.5f);
+        }
+
+        levels.push_back(std::move(level));
+    }
+}
+
+PeakPyramid::Peak PeakPyramid::getPeak(juce::int64 startSample, juce::int64 endSample) const noexcept {
+    if (isEmpty()) {
+        return {};
+    }
+
+    startSample = juce::jlimit(static_cast<juce::int64>(0), numSamples - 1, startSample);
+    endSample = juce::jlimit(startSample + 1, numSamples, endSample);
+
+    // Use the coarsest level whose bins still fit inside the span.
+    size_t level = 0;
+    const auto span = endSample - startSample;
+
+    while (level + 1 < levels.size() && (static_cast<juce::int64>(binSize) << (level + 1)) <= span) {
+        ++level;
+    }
+
+    const auto& peaks = levels[level];
+    const auto levelBinSize = static_cast<juce::int64>(binSize) << level;
+    const auto first = static_cast<size_t>(startSample / levelBinSize);
+    const auto last = juce::jmin(static_cast<size_t>((endSample - 1) / levelBinSize), peaks.size() - 1);
+
+    Peak result = peaks[first];
+    float sumOfSquares = result.rms * result.rms;
+
+    for (auto i = first + 1; i <= last; ++i) {
+        result.min = juce::jmin(result.min, peaks[i].min);
+        result.max = juce::jmax(result.max, peaks[i].max);
+        sumOfSquares += peaks[i].rms * peaks[i].rms;
+    }
+
+    result.rms = std::sqrt(sumOfSquares / static_cast<float>(last - first + 1));
+
+    return result;
+}
+
+juce::int64 PeakPyramid::findEndAbove(float threshold) const noexcept {
+    if (isEmpty()) {
+        return 0;
+    }
+
+    const auto& bins = levels.front();
+
+    for (auto i = bins.size(); i-- > 0;) {
+        if (bins[i].max > threshold || -bins[i].min > threshold) {
+            return juce::jmin(numSamples, static_cast<juce::int64>(i + 1) * binSize);
+        }
+    }
+
+    return 0;
+}
+
+void PeakPyramid::writeTo(juce::OutputStream& stream) const {
+    stream.writeInt64(numSamples);
+    stream.writeInt(binSize);
+    stream.writeInt(static_cast<int>(levels.size()));
+
+    for (const auto& level : levels) {
+        stream.writeInt(static_cast<int>(level.size()));
+
+        for (const auto& peak : level) {
+            stream.writeFloat(peak.min);
+            stream.writeFloat(peak.max);
+            stream.writeFloat(peak.rms);
+        }
+    }
+}
+
+bool PeakPyramid::readFrom(juce::InputStream& stream) {
+    levels.clear();
+    numSamples = stream.readInt64();
+    binSize = stream.readInt();
+
+    const auto numLevels = stream.readInt();
+
+    // Only accept exactly what reset() and finish() would have built for this
+    // many samples: getPeak relies on every level covering all of them, and on
+    // none being empty.
+    auto expectedBinSize = static_cast<juce::int64>(minBinSize);
+
+    while (numSamples / expectedBinSize > maxLevelZeroBins) {
+        expectedBinSize *= 2;
+    }
+
+    auto expectedPeaks = numSamples > 0 && binSize == expectedBinSize ? (numSamples + binSize - 1) / binSize : 0;
+
+    for (int i = 0; i < numLevels && !stream.isExhausted(); ++i) {
+        const auto numPeaks = stream.readInt();
+
+        // Each peak takes twelve bytes, so a count larger than what's left is
+        // a damaged file rather than something to allocate for.
+        if (numPeaks <= 0 || numPeaks != expectedPeaks || numPeaks > stream.getNumBytesRemaining() / 12) {
+            break;
+        }
+
+        // Each level halves the one below, and the single top peak is the last.
+        expectedPeaks = expectedPeaks > 1 ? (expectedPeaks + 1) / 2 : 0;
+
+        auto& level = levels.emplace_back(static_cast<size_t>(numPeaks));
+
+        for (auto& peak : level) {
+            peak.min = stream.readFloat();
+            peak.max = stream.readFloat();
+            peak.rms = stream.readFloat();
+        }
+    }
+
+    if (levels.empty() || static_cast<int>(levels.size()) != numLevels || levels.back().size() != 1) {
+        levels.clear();
+        numSamples = 0;
+        binSize = minBinSize;
+        return false;
+    }
+
+    return true;
+}
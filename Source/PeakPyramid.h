@@ -0,0 +1,66 @@
+/*
+  ==============================================================================
+
+    PeakPyramid.h
+    Created: 17 Oct 2026 1:05:39pm
+    Author:  tmobr
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/*
+    Min, max and RMS of a sample at several resolutions. Level 0 holds one peak
+    per base bin and each level above halves the resolution, so any span of
+    samples can be summarised from at most a few stored peaks.
+
+    Built once on a background thread and then only read.
+*/
+class PeakPyramid
+{
+public:
+    struct Peak
+    {
+        float min = 0.0f, max = 0.0f, rms = 0.0f;
+    };
+
+    PeakPyramid();
+
+    void reset(juce::int64 totalNumSamples);
+    void addSamples(const float* const* channels, int numChannels, int numSamples);
+    void finish();
+
+    bool isEmpty() const noexcept { return levels.empty() || levels.front().empty(); }
+    juce::int64 getNumSamples() const noexcept { return numSamples; }
+
+    // Cost depends only on how many peaks cover the span, never on its length.
+    Peak getPeak(juce::int64 startSample, juce::int64 endSample) const noexcept;
+
+    // The end of the last base bin that reaches above the threshold, or 0 if
+    // none does. Never earlier than the last sample that does.
+    juce::int64 findEndAbove(float threshold) const noexcept;
+
+    // Every level is stored, so a kit's peaks are ready as soon as they're read.
+    void writeTo(juce::OutputStream& stream) const;
+    bool readFrom(juce::InputStream& stream);
+
+private:
+    void flushBin();
+
+    static constexpr int maxLevelZeroBins = 1 << 16;
+    static constexpr int minBinSize = 16;
+
+    std::vector<std::vector<Peak>> levels;
+    int binSize = minBinSize;
+    juce::int64 numSamples = 0;
+
+    float binMin = 0.0f, binMax = 0.0f;
+    double binSumOfSquares = 0.0;
+    int binCount = 0, binValues = 0;
+
+    JUCE_LEAK_DETECTOR (PeakPyramid)
+};
@@ -0,0 +1,75 @@
+/*
+  ==============================================================================
+
+    PlayheadFifo.cpp
+    Created: 17 Oct 2026 5:12:07pm
+    Author:  tmobr
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "PlayheadFifo.h"
+
+//==============================================================================
+PlayheadFifo::PlayheadFifo()
+{
+    mPartial.reserve(capacity);
+}
+
+void PlayheadFifo::publish(const VoiceBank& bank) noexcept {
+    const auto numVoices = bank.getNumActive();
+
+    if (numVoices == 0 && mLastWasEmpty) {
+        return;
+    }
+
+    // Dropped without a trace. If this was the empty block, mLastWasEmpty is
+    // still false, so the next call tries again.
+    if (mFifo.getFreeSpace() < numVoices + 1) {
+        return;
+    }
+
+    const auto now = juce::Time::getMillisecondCounterHiRes();
+    const auto sampleRate = bank.getSampleRate();
+    int slot = 0;
+
+    mFifo.write(numVoices + 1).forEach([&] (int index) {
+        auto& entry = mEntries[static_cast<size_t>(index)];
+
+        if (slot < numVoices) {
+            entry.voice = bank.getVoiceInSlot(slot);
+            entry.sample = &bank.getSoundInSlot(slot)->getSampleData();
+            entry.position = bank.getPositionInSlot(slot);
+            entry.framesPerSecond = bank.getIncrementInSlot(slot) * sampleRate;
+            entry.level = bank.getLevelInSlot(slot);
+        }
+        else {
+            entry.voice = -1;
+        }
+
+        entry.time = now;
+        ++slot;
+    });
+
+    mLastWasEmpty = numVoices == 0;
+}
+
+bool PlayheadFifo::readLatest(std::vector<VoicePosition>& latest) {
+    bool gotBlock = false;
+
+    mFifo.read(mFifo.getNumReady()).forEach([&] (int index) {
+        const auto& entry = mEntries[static_cast<size_t>(index)];
+
+        if (entry.voice >= 0) {
+            mPartial.push_back(entry);
+            return;
+        }
+
+        latest.assign(mPartial.begin(), mPartial.end());
+        mPartial.clear();
+        gotBlock = true;
+    });
+
+    return gotBlock;
+}
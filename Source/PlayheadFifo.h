@@ -0,0 +1,60 @@
+/*
+  ==============================================================================
+
+    PlayheadFifo.h
+    Created: 17 Oct 2026 5:12:07pm
+    Author:  tmobr
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "VoiceBank.h"
+
+//==============================================================================
+struct VoicePosition
+{
+    int voice = -1;                         // -1 marks the end of a block's positions
+    const SampleData* sample = nullptr;     // only compared, never dereferenced
+    double position = 0.0;                  // in frames of the voice's sample
+    double framesPerSecond = 0.0;
+    float level = 0.0f;
+    double time = 0.0;                      // Time::getMillisecondCounterHiRes() when published
+};
+
+//==============================================================================
+/*
+    Carries voice positions from the audio thread to the GUI without locks.
+    Every block's positions are followed by an end marker, so the reader only
+    ever sees whole blocks. If the reader has fallen behind, a block is dropped
+    as a whole rather than split.
+*/
+class PlayheadFifo
+{
+public:
+    PlayheadFifo();
+
+    // Audio thread. Call it every block, idle ones included: it costs nothing
+    // once an empty block has gone through, but until then it keeps trying.
+    void publish(const VoiceBank& bank) noexcept;
+
+    // Message thread. Returns true and fills latest if at least one complete
+    // block arrived since the last call.
+    bool readLatest(std::vector<VoicePosition>& latest);
+
+private:
+    static constexpr int capacity = 4096;
+
+    juce::AbstractFifo mFifo{ capacity };
+    std::array<VoicePosition, capacity> mEntries;
+
+    // Audio thread only. Saves writing an empty block every time while idle.
+    bool mLastWasEmpty = false;
+
+    // Message thread only. Positions of a block whose end marker hasn't been read yet.
+    std::vector<VoicePosition> mPartial;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PlayheadFifo)
+};
@@ -1,54 +1,85 @@
-/*
-  ==============================================================================
-
-    This file contains the basic framework code for a JUCE plugin editor.
-
-  ==============================================================================
-*/
-
-#include "PluginProcessor.h"
-#include "PluginEditor.h"
-
-//==============================================================================
-SimpleSamplerAudioProcessorEditor::SimpleSamplerAudioProcessorEditor (SimpleSamplerAudioProcessor& p)
-    : AudioProcessorEditor (&p), waveThumbnail(p), mADSR(p), audioProcessor (p)
-{
-    auto image = juce::ImageCache::getFromMemory(BinaryData::logo_png , BinaryData::logo_pngSize);
-
-    if (!image.isNull()) {
-        mImageComponent.setImage(image, juce::RectanglePlacement::stretchToFit);
-    }
-    else {
-        jassert(!image.isNull());
-    }
-
-    addAndMakeVisible(waveThumbnail);
-    addAndMakeVisible(mADSR);
-    addAndMakeVisible(mImageComponent);
-
-    startTimerHz(30);
-
-    setSize (600, 400);
-}
-
-SimpleSamplerAudioProcessorEditor::~SimpleSamplerAudioProcessorEditor()
-{
-    stopTimer();
-}
-
-//==============================================================================
-void SimpleSamplerAudioProcessorEditor::paint (juce::Graphics& g)
-{
-    g.fillAll (juce::Colours::black);
-}
-
-void SimpleSamplerAudioProcessorEditor::resized()
-{
-    waveThumbnail.setBoundsRelative(0.0f, 0.25f, 1.0f, 0.5f);
-    mADSR.setBoundsRelative(0.0f, 0.75f, 1.0f, 0.25f);
-    mImageComponent.setBoundsRelative(0.02f, 0.02f, 0.2f, 0.2f);
-}
-
-void SimpleSamplerAudioProcessorEditor::timerCallback() {
-    repaint();
-}
+/*
+  ==============================================================================
+
+    This file contains the basic framework code for a JUCE plugin editor.
+
+  ==============================================================================
+*/
+
+#include "PluginProcessor.h"
+#include "PluginEditor.h"
+
+//==============================================================================
+SimpleSamplerAudioProcessorEditor::SimpleSamplerAudioProcessorEditor (SimpleSamplerAudioProcessor& p)
+    : AudioProcessorEditor (&p), waveThumbnail(p), mADSR(p), mLoadMeter(p), mImportProgress(p), audioProcessor (p)
+{
+    auto image = juce::ImageCache::getFromMemory(BinaryData::logo_png , BinaryData::logo_pngSize);
+
+    if (!image.isNull()) {
+        mImageComponent.setImage(image, juce::RectanglePlacement::stretchToFit);
+    }
+    else {
+        jassert(!image.isNull());
+    }
+
+    addAndMakeVisible(waveThumbnail);
+    addAndMakeVisible(mADSR);
+    addAndMakeVisible(mImageComponent);
+    addAndMakeVisible(mLoadMeter);
+    addChildComponent(mImportProgress);
+    addAndMakeVisible(mExportButton);
+
+    mExportButton.onClick = [this] { exportKit(); };
+
+    // The thumbnail drives its own playhead redraws from the display's vblank,
+    // so the editor itself only repaints when something invalidates it.
+    setOpaque(true);
+
+    setSize (600, 400);
+}
+
+SimpleSamplerAudioProcessorEditor::~SimpleSamplerAudioProcessorEditor()
+{
+}
+
+//==============================================================================
+void SimpleSamplerAudioProcessorEditor::paint (juce::Graphics& g)
+{
+    g.fillAll (juce::Colours::black);
+}
+
+void SimpleSamplerAudioProcessorEditor::resized()
+{
+    waveThumbnail.setBoundsRelative(0.0f, 0.25f, 1.0f, 0.5f);
+    mADSR.setBoundsRelative(0.0f, 0.75f, 1.0f, 0.25f);
+    mImageComponent.setBoundsRelative(0.02f, 0.02f, 0.2f, 0.2f);
+    mLoadMeter.setBoundsRelative(0.5f, 0.02f, 0.48f, 0.06f);
+    mImportProgress.setBoundsRelative(0.5f, 0.1f, 0.48f, 0.08f);
+    mExportButton.setBoundsRelative(0.25f, 0.02f, 0.2f, 0.08f);
+}
+
+void SimpleSamplerAudioProcessorEditor::exportKit() {
+    if (audioProcessor.getLoadedSample() == nullptr || audioProcessor.isExporting()) {
+        return;
+    }
+
+    mKitChooser = std::make_unique<juce::FileChooser>("Export Kit", juce::File(), juce::String("*") + SampleKit::fileExtension);
+
+    const auto flags = juce::FileBrowserComponent::saveMode | juce::FileBrowserComponent::warnAboutOverwriting;
+
+    mKitChooser->launchAsync(flags, [this] (const juce::FileChooser& chooser) {
+        const auto file = chooser.getResult();
+
+        if (file == juce::File()) {
+            return;
+        }
+
+        // Progress shows in mImportProgress; the alert needs nothing from
+        // the editor, so it doesn't matter if that's gone by the time it fails.
+        audioProcessor.exportKit(file.withFileExtension(SampleKit::fileExtension), [file] (bool exported) {
+            if (!exported) {
+                juce::AlertWindow::showMessageBoxAsync(juce::MessageBoxIconType::WarningIcon, "Export Kit", "The kit couldn't be written to " + file.getFullPathName());
+            }
+        });
+    });
+}
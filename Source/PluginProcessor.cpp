@@ -1,267 +1,501 @@
-/*
-  ==============================================================================
-
-    This file contains the basic framework code for a JUCE plugin processor.
-
-  ==============================================================================
-*/
-
-#include "PluginProcessor.h"
-#include "PluginEditor.h"
-
-//==============================================================================
-SimpleSamplerAudioProcessor::SimpleSamplerAudioProcessor()
-#ifndef JucePlugin_PreferredChannelConfigurations
-     : AudioProcessor (BusesProperties()
-                     #if ! JucePlugin_IsMidiEffect
-                      #if ! JucePlugin_IsSynth
-                       .withInput  ("Input",  juce::AudioChannelSet::stereo(), true)
-                      #endif
-                       .withOutput ("Output", juce::AudioChannelSet::stereo(), true)
-                     #endif
-                       ), APVTS(*this, nullptr, "PARAMETERS", createParameters())
-#endif
-{
-    mFormatManager.registerBasicFormats();
-    APVTS.state.addListener(this);
-
-    for (int i = 0; i < mNumVoices; i++) {
-        mSampler.addVoice(new juce::SamplerVoice());
-    }
-}
-
-SimpleSamplerAudioProcessor::~SimpleSamplerAudioProcessor()
-{
-    mFormatReader = nullptr;
-}
-
-//==============================================================================
-const juce::String SimpleSamplerAudioProcessor::getName() const
-{
-    return JucePlugin_Name;
-}
-
-bool SimpleSamplerAudioProcessor::acceptsMidi() const
-{
-   #if JucePlugin_WantsMidiInput
-    return true;
-   #else
-    return false;
-   #endif
-}
-
-bool SimpleSamplerAudioProcessor::producesMidi() const
-{
-   #if JucePlugin_ProducesMidiOutput
-    return true;
-   #else
-    return false;
-   #endif
-}
-
-bool SimpleSamplerAudioProcessor::isMidiEffect() const
-{
-   #if JucePlugin_IsMidiEffect
-    return true;
-   #else
-    return false;
-   #endif
-}
-
-double SimpleSamplerAudioProcessor::getTailLengthSeconds() const
-{
-    return 0.0;
-}
-
-int SimpleSamplerAudioProcessor::getNumPrograms()
-{
-    return 1;   // NB: some hosts don't cope very well if you tell them there are 0 programs,
-                // so this should be at least 1, even if you're not really implementing programs.
-}
-
-int SimpleSamplerAudioProcessor::getCurrentProgram()
-{
-    return 0;
-}
-
-void SimpleSamplerAudioProcessor::setCurrentProgram (int index)
-{
-}
-
-const juce::String SimpleSamplerAudioProcessor::getProgramName (int index)
-{
-    return {};
-}
-
-void SimpleSamplerAudioProcessor::changeProgramName (int index, const juce::String& newName)
-{
-}
-
-//==============================================================================
-void SimpleSamplerAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
-{
-    mSampler.setCurrentPlaybackSampleRate(sampleRate);
-
-    updateADSR();
-}
-
-void SimpleSamplerAudioProcessor::releaseResources()
-{
-    // When playback stops, you can use this as an opportunity to free up any
-    // spare memory, etc.
-}
-
-#ifndef JucePlugin_PreferredChannelConfigurations
-bool SimpleSamplerAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts) const
-{
-  #if JucePlugin_IsMidiEffect
-    juce::ignoreUnused (layouts);
-    return true;
-  #else
-    // This is the place where you check if the layout is supported.
-    // In this template code we only support mono or stereo.
-    // Some plugin hosts, such as certain GarageBand versions, will only
-    // load plugins that support stereo bus layouts.
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-     && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
-        return false;
-
-    // This checks if the input layout matches the output layout
-   #if ! JucePlugin_IsSynth
-    if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet())
-        return false;
-   #endif
-
-    return true;
-  #endif
-}
-#endif
-
-void SimpleSamplerAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
-{
-    juce::ScopedNoDenormals noDenormals;
-    auto totalNumInputChannels  = getTotalNumInputChannels();
-    auto totalNumOutputChannels = getTotalNumOutputChannels();
-
-    for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
-        buffer.clear (i, 0, buffer.getNumSamples());
-
-    if (shouldUpdate) {
-        updateADSR();
-    }
-
-    juce::MidiMessage m;
-    juce::MidiBuffer::Iterator it{ midiMessages };
-    int sample;
-
-    while (it.getNextEvent(m, sample)) {
-        if (m.isNoteOn()) {
-            isNotePlayed = true;
-        }
-        else if (m.isNoteOff()) {
-            isNotePlayed = false;
-        }
-    }
-
-    sampleCount = isNotePlayed ? sampleCount += buffer.getNumSamples() : 0;
-
-    mSampler.renderNextBlock(buffer, midiMessages, 0, buffer.getNumSamples());
-}
-
-//==============================================================================
-bool SimpleSamplerAudioProcessor::hasEditor() const
-{
-    return true; // (change this to false if you choose to not supply an editor)
-}
-
-juce::AudioProcessorEditor* SimpleSamplerAudioProcessor::createEditor()
-{
-    return new SimpleSamplerAudioProcessorEditor (*this);
-}
-
-//==============================================================================
-void SimpleSamplerAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
-{
-    // You should use this method to store your parameters in the memory block.
-    // You could do that either as raw data, or use the XML or ValueTree classes
-    // as intermediaries to make it easy to save and load complex data.
-}
-
-void SimpleSamplerAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
-{
-    // You should use this method to restore your parameters from this memory block,
-    // whose contents will have been created by the getStateInformation() call.
-}
-
-void SimpleSamplerAudioProcessor::loadFile() {
-    mSampler.clearSounds();
-
-    juce::FileChooser chooser{ "Please load a file" };
-
-    if (chooser.browseForFileToOpen()) {
-        auto file = chooser.getResult();
-        mFormatReader = mFormatManager.createReaderFor(file);
-    }
-
-    setKeysAndSound();
-}
-
-void SimpleSamplerAudioProcessor::loadFile(const juce::String& path) {
-    mSampler.clearSounds();
-
-    auto file = juce::File(path);
-    mFormatReader = mFormatManager.createReaderFor(file);
-
-    auto sampleLength = static_cast<int>(mFormatReader->lengthInSamples);
-
-    mWaveForm.setSize(1, sampleLength);
-    mFormatReader->read(&mWaveForm, 0, sampleLength, 0, true, false);
-
-    auto buffer = mWaveForm.getReadPointer(0);
-
-    setKeysAndSound();
-
-    updateADSR();
-}
-
-void SimpleSamplerAudioProcessor::setKeysAndSound() {
-    juce::BigInteger range;
-    range.setRange(0, 128, true);
-
-    mSampler.addSound(new juce::SamplerSound("Sample", *mFormatReader, range, 60, 0.01, 0.01, 300));
-}
-
-void SimpleSamplerAudioProcessor::updateADSR() {
-    ADSRparams.attack = APVTS.getRawParameterValue("ATTACK")->load();
-    ADSRparams.decay = APVTS.getRawParameterValue("DECAY")->load();
-    ADSRparams.sustain = APVTS.getRawParameterValue("SUSTAIN")->load();
-    ADSRparams.release = APVTS.getRawParameterValue("RELEASE")->load();
-
-    for (int i = 0; i < mSampler.getNumSounds(); ++i) {
-        if (auto sound = dynamic_cast<juce::SamplerSound*>(mSampler.getSound(i).get())) {
-            sound->setEnvelopeParameters(ADSRparams);
-        }
-    }
-}
-
-juce::AudioProcessorValueTreeState::ParameterLayout SimpleSamplerAudioProcessor::createParameters() {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> parameters;
-
-    parameters.push_back(std::make_unique<juce::AudioParameterFloat> ("ATTACK", "Attack", 0.0f, 5.0f, 0.0f));
-    parameters.push_back(std::make_unique<juce::AudioParameterFloat>("DECAY", "Decay", 0.0f, 5.0f, 0.0f));
-    parameters.push_back(std::make_unique<juce::AudioParameterFloat>("SUSTAIN", "Sustain", 0.0f, 5.0f, 0.0f));
-    parameters.push_back(std::make_unique<juce::AudioParameterFloat>("RELEASE", "Release", 0.0f, 5.0f, 0.0f));
-
-    return { parameters.begin(), parameters.end() };
-}
-
-void SimpleSamplerAudioProcessor::valueTreePropertyChanged(juce::ValueTree& treeWhosePropertyHasChanged, const juce::Identifier& property) {
-    shouldUpdate = true;
-}
-
-//==============================================================================
-// This creates new instances of the plugin..
-juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
-{
-    return new SimpleSamplerAudioProcessor();
-}
+/*
+  ==============================================================================
+
+    This file contains the basic framework code for a JUCE plugin processor.
+
+  ==============================================================================
+*/
+
+#include "PluginProcessor.h"
+#include "PluginEditor.h"
+
+//==============================================================================
+SimpleSamplerAudioProcessor::SimpleSamplerAudioProcessor()
+#ifndef JucePlugin_PreferredChannelConfigurations
+     : AudioProcessor (BusesProperties()
+                     #if ! JucePlugin_IsMidiEffect
+                      #if ! JucePlugin_IsSynth
+                       .withInput  ("Input",  juce::AudioChannelSet::stereo(), true)
+                      #endif
+                       .withOutput ("Output", juce::AudioChannelSet::stereo(), true)
+                     #endif
+                       ), mLoader(mFormatManager, [this] (LoadedSample::Ptr sample) { sampleLoaded(sample); }),
+                       APVTS(*this, nullptr, "PARAMETERS", createParameters())
+#endif
+{
+    mFormatManager.registerBasicFormats();
+
+    mAttack = APVTS.getRawParameterValue("ATTACK");
+    mDecay = APVTS.getRawParameterValue("DECAY");
+    mSustain = APVTS.getRawParameterValue("SUSTAIN");
+    mRelease = APVTS.getRawParameterValue("RELEASE");
+    mPolyphony = APVTS.getRawParameterValue("POLYPHONY");
+    mStealMode = APVTS.getRawParameterValue("STEAL_MODE");
+    mQuality = APVTS.getRawParameterValue("QUALITY");
+
+    mLoader.startThread();
+}
+
+SimpleSamplerAudioProcessor::~SimpleSamplerAudioProcessor()
+{
+    mExportPool.removeAllJobs(true, 4000);
+    mLoader.stopThread(4000);
+
+    if (auto* sound = mPendingSound.exchange(nullptr)) {
+        sound->decReferenceCount();
+    }
+}
+
+//==============================================================================
+const juce::String SimpleSamplerAudioProcessor::getName() const
+{
+    return JucePlugin_Name;
+}
+
+bool SimpleSamplerAudioProcessor::acceptsMidi() const
+{
+   #if JucePlugin_WantsMidiInput
+    return true;
+   #else
+    return false;
+   #endif
+}
+
+bool SimpleSamplerAudioProcessor::producesMidi() const
+{
+   #if JucePlugin_ProducesMidiOutput
+    return true;
+   #else
+    return false;
+   #endif
+}
+
+bool SimpleSamplerAudioProcessor::isMidiEffect() const
+{
+   #if JucePlugin_IsMidiEffect
+    return true;
+   #else
+    return false;
+   #endif
+}
+
+// Hosts use this to decide when an instance that stopped receiving notes can
+// be suspended; nothing sounds for longer than the release after a note-off.
+double SimpleSamplerAudioProcessor::getTailLengthSeconds() const
+{
+    return juce::jmax(0.0f, mRelease->load());
+}
+
+int SimpleSamplerAudioProcessor::getNumPrograms()
+{
+    return 1;   // NB: some hosts don't cope very well if you tell them there are 0 programs,
+                // so this should be at least 1, even if you're not really implementing programs.
+}
+
+int SimpleSamplerAudioProcessor::getCurrentProgram()
+{
+    return 0;
+}
+
+void SimpleSamplerAudioProcessor::setCurrentProgram (int index)
+{
+}
+
+const juce::String SimpleSamplerAudioProcessor::getProgramName (int index)
+{
+    return {};
+}
+
+void SimpleSamplerAudioProcessor::changeProgramName (int index, const juce::String& newName)
+{
+}
+
+//==============================================================================
+void SimpleSamplerAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
+{
+    const auto parameters = readParameters();
+
+    // Voices are only ever allocated here; raising the polyphony while playing
+    // takes effect the next time the host prepares the plugin.
+    mSampler.setNumVoices(parameters.polyphony);
+    mSampler.setCurrentPlaybackSampleRate(sampleRate);
+    mSampler.getVoiceBank().setEnvelopeParameters(parameters.envelope, 0);
+
+    mWorkers.setNumThreads(mNumRenderThreads, sampleRate, samplesPerBlock);
+    mSampler.getVoiceBank().setWorkers(mWorkers.getNumThreads() > 0 ? &mWorkers : nullptr);
+
+    mLoadMonitor.prepare(sampleRate);
+}
+
+void SimpleSamplerAudioProcessor::releaseResources()
+{
+    mSampler.getVoiceBank().setWorkers(nullptr);
+    mWorkers.setNumThreads(0);
+}
+
+#ifndef JucePlugin_PreferredChannelConfigurations
+bool SimpleSamplerAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts) const
+{
+  #if JucePlugin_IsMidiEffect
+    juce::ignoreUnused (layouts);
+    return true;
+  #else
+    // This is the place where you check if the layout is supported.
+    // In this template code we only support mono or stereo.
+    // Some plugin hosts, such as certain GarageBand versions, will only
+    // load plugins that support stereo bus layouts.
+    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
+     && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+        return false;
+
+    // This checks if the input layout matches the output layout
+   #if ! JucePlugin_IsSynth
+    if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet())
+        return false;
+   #endif
+
+    return true;
+  #endif
+}
+#endif
+
+void SimpleSamplerAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+{
+    juce::ScopedNoDenormals noDenormals;
+    LoadMonitor::ScopedTimer loadTimer(mLoadMonitor, buffer.getNumSamples());
+
+    auto totalNumInputChannels  = getTotalNumInputChannels();
+    auto totalNumOutputChannels = getTotalNumOutputChannels();
+
+    for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
+        buffer.clear (i, 0, buffer.getNumSamples());
+
+    takePendingSound();
+
+    // Nothing is sounding and nothing can start, so the cleared buffer is
+    // already the output. Everything skipped here is applied before the next
+    // block that renders, and with no voices it would take effect at once.
+    // Voices that end without rendering, such as notes under an envelope with
+    // no sustain, are finished by the render call of the block they end in.
+    if (midiMessages.isEmpty() && mSampler.getNumActiveVoices() == 0) {
+        // Until the GUI has been told nothing is playing, in case the FIFO
+        // was full when the last voice ended.
+        mPlayheads.publish(mSampler.getVoiceBank());
+        loadTimer.setNumActiveVoices(0);
+        return;
+    }
+
+    const auto parameters = readParameters();
+
+    mSampler.setPolyphony(parameters.polyphony);
+    mSampler.setStealMode(parameters.stealMode);
+
+    // Bounces aren't bound by the clock, so they always get the best resampler.
+    mSampler.getVoiceBank().setQuality(isNonRealtime() ? ResamplingQuality::sinc32 : parameters.quality);
+
+    // Glides from the last block's envelope to this one's across the block.
+    mSampler.getVoiceBank().setEnvelopeParameters(parameters.envelope, buffer.getNumSamples());
+
+    mSampler.renderNextBlock(buffer, midiMessages, 0, buffer.getNumSamples());
+
+    mPlayheads.publish(mSampler.getVoiceBank());
+
+    loadTimer.setNumActiveVoices(mSampler.getNumActiveVoices());
+}
+
+//==============================================================================
+bool SimpleSamplerAudioProcessor::hasEditor() const
+{
+    return true; // (change this to false if you choose to not supply an editor)
+}
+
+juce::AudioProcessorEditor* SimpleSamplerAudioProcessor::createEditor()
+{
+    return new SimpleSamplerAudioProcessorEditor (*this);
+}
+
+//==============================================================================
+// The state is a binary ValueTree holding the parameters and the zones. Only
+// paths and hashes are saved, never audio, so it stays small however large
+// the samples are.
+void SimpleSamplerAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
+{
+    juce::ValueTree state("SAMPLER_STATE");
+    state.setProperty("VERSION", 1, nullptr);
+    state.appendChild(APVTS.copyState(), nullptr);
+    state.appendChild(createZoneState(), nullptr);
+
+    juce::MemoryOutputStream stream(destData, false);
+    state.writeToStream(stream);
+}
+
+// Parameters apply straight away. The samples load on this instance's loader
+// thread, so the host's thread never waits for a decode and every instance in
+// a session loads at once.
+void SimpleSamplerAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
+{
+    auto state = juce::ValueTree::readFromData(data, static_cast<size_t>(sizeInBytes));
+
+    if (!state.hasType("SAMPLER_STATE")) {
+        return;
+    }
+
+    auto parameters = state.getChildWithName(APVTS.state.getType());
+
+    if (parameters.isValid()) {
+        APVTS.replaceState(parameters);
+    }
+
+    auto zones = readZoneState(state.getChildWithName("ZONES"));
+
+    if (!zones.empty()) {
+        loadZones(zones);
+    }
+}
+
+juce::ValueTree SimpleSamplerAudioProcessor::createZoneState() const {
+    juce::ValueTree zonesState("ZONES");
+    const juce::ScopedLock sl(mSessionLock);
+
+    for (const auto& zone : mSessionZones) {
+        zonesState.appendChild(zone.toValueTree(), nullptr);
+    }
+
+    return zonesState;
+}
+
+std::vector<SampleZone> SimpleSamplerAudioProcessor::readZoneState(const juce::ValueTree& state) {
+    std::vector<SampleZone> zones;
+
+    for (const auto& zoneState : state) {
+        if (!zoneState.hasType("ZONE")) {
+            continue;
+        }
+
+        auto zone = SampleZone::fromValueTree(zoneState);
+
+        if (zone.file != juce::File()) {
+            zones.push_back(zone);
+        }
+    }
+
+    return zones;
+}
+
+void SimpleSamplerAudioProcessor::loadFile() {
+    juce::FileChooser chooser{ "Please load a file" };
+
+    if (chooser.browseForFileToOpen()) {
+        loadFile(chooser.getResult().getFullPathName());
+    }
+}
+
+void SimpleSamplerAudioProcessor::loadFile(const juce::String& path) {
+    SampleZone zone;
+    zone.file = juce::File(path);
+
+    requestZones({ zone }, SampleKit::isKitFile(zone.file));
+}
+
+void SimpleSamplerAudioProcessor::loadZones(const std::vector<SampleZone>& zones) {
+    requestZones(zones, false);
+}
+
+void SimpleSamplerAudioProcessor::requestZones(const std::vector<SampleZone>& zones, bool applyKitParameters) {
+    {
+        const juce::ScopedLock sl(mSessionLock);
+        mSessionZones = zones;
+        mApplyKitParameters = applyKitParameters;
+    }
+
+    mLoader.loadAsync(zones);
+}
+
+void SimpleSamplerAudioProcessor::importFiles(const juce::StringArray& paths) {
+    juce::Array<juce::File> files;
+
+    for (const auto& path : paths) {
+        const juce::File file(path);
+
+        if (file.isDirectory()) {
+            for (const auto& entry : juce::RangedDirectoryIterator(file, true, mFormatManager.getWildcardForAllFormats())) {
+                files.addIfNotAlreadyThere(entry.getFile());
+            }
+        }
+        else if (canImport(file)) {
+            files.addIfNotAlreadyThere(file);
+        }
+    }
+
+    if (files.size() == 1) {
+        loadFile(files.getReference(0).getFullPathName());
+    }
+    else if (files.size() > 1) {
+        loadZones(createKitZones(files));
+    }
+}
+
+bool SimpleSamplerAudioProcessor::canImport(const juce::File& file) {
+    return file.isDirectory()
+        || SampleKit::isKitFile(file)
+        || mFormatManager.findFormatForFileExtension(file.getFileExtension()) != nullptr;
+}
+
+bool SimpleSamplerAudioProcessor::exportKit(const juce::File& file, std::function<void (bool)> onFinished) {
+    auto sample = getLoadedSample();
+
+    if (sample == nullptr || mExporting.exchange(true)) {
+        return false;
+    }
+
+    mExportProgress = 0.0;
+    mExportCancelled = false;
+
+    // The parameters are copied here, on the message thread, so the export
+    // saves them as they were when it was asked for.
+    mExportPool.addJob([this, sample, file, parameters = APVTS.copyState(), onFinished = std::move(onFinished)] {
+        auto* job = juce::ThreadPoolJob::getCurrentThreadPoolJob();
+
+        const auto exported = SampleKit::write(file, *sample->keymap, parameters, mFormatManager, [this, job] (double progress) {
+            mExportProgress = progress;
+            return !mExportCancelled && !job->shouldExit();
+        });
+
+        const bool cancelled = mExportCancelled;
+        mExporting = false;
+
+        if (!cancelled && onFinished != nullptr) {
+            juce::MessageManager::callAsync([onFinished, exported] { onFinished(exported); });
+        }
+    });
+
+    return true;
+}
+
+std::vector<SampleZone> SimpleSamplerAudioProcessor::createKitZones(const juce::Array<juce::File>& files) {
+    auto sorted = files;
+
+    // Natural order, so "Kick 2" lands below "Kick 10".
+    std::sort(sorted.begin(), sorted.end(), [] (const juce::File& a, const juce::File& b) {
+        return a.getFileName().compareNatural(b.getFileName()) < 0;
+    });
+
+    constexpr int firstKitKey = 36;
+    const auto numZones = juce::jmin(sorted.size(), 128);
+    const auto firstKey = juce::jmin(firstKitKey, 128 - numZones);
+
+    std::vector<SampleZone> zones;
+
+    for (int i = 0; i < numZones; ++i) {
+        SampleZone zone;
+        zone.file = sorted.getReference(i);
+        zone.lowKey = zone.highKey = zone.rootNote = firstKey + i;
+
+        zones.push_back(zone);
+    }
+
+    return zones;
+}
+
+LoadedSample::Ptr SimpleSamplerAudioProcessor::getLoadedSample() const {
+    const juce::SpinLock::ScopedLockType sl(mLoadedSampleLock);
+    return mLoadedSample;
+}
+
+void SimpleSamplerAudioProcessor::handleAsyncUpdate() {
+    juce::ValueTree parameters;
+
+    {
+        const juce::ScopedLock sl(mSessionLock);
+        std::swap(parameters, mPendingKitParameters);
+    }
+
+    if (parameters.hasType(APVTS.state.getType())) {
+        APVTS.replaceState(parameters);
+    }
+}
+
+void SimpleSamplerAudioProcessor::sampleLoaded(LoadedSample::Ptr sample) {
+    {
+        const juce::SpinLock::ScopedLockType sl(mLoadedSampleLock);
+        mLoadedSample = sample;
+    }
+
+    // Zones whose files are missing stay in the session, so saving while a
+    // drive is offline doesn't lose them.
+    {
+        const juce::ScopedLock sl(mSessionLock);
+
+        for (auto& sessionZone : mSessionZones) {
+            for (auto* zone : sample->keymap->getZones()) {
+                if (zone->getFile() == sessionZone.file) {
+                    sessionZone.contentHash = zone->getZone().contentHash;
+                }
+            }
+        }
+
+        if (mApplyKitParameters && sample->kitParameters.isValid()) {
+            mApplyKitParameters = false;
+            mPendingKitParameters = sample->kitParameters;
+            triggerAsyncUpdate();
+        }
+    }
+
+    // The loader still owns the sample, so dropping a stale pending sound here
+    // never deletes it.
+    sample->keymap->incReferenceCount();
+
+    if (auto* stale = mPendingSound.exchange(sample->keymap.get())) {
+        stale->decReferenceCount();
+    }
+}
+
+void SimpleSamplerAudioProcessor::takePendingSound() {
+    auto* sound = mPendingSound.exchange(nullptr);
+
+    if (sound == nullptr) {
+        return;
+    }
+
+    // The sound takes over the synthesiser's one slot in place, so nothing is
+    // allocated or freed here. Voices still playing the old sound keep it
+    // alive until they finish, and the loader frees it later.
+    mSampler.setSound(sound);
+
+    sound->decReferenceCount();
+}
+
+SimpleSamplerAudioProcessor::ParameterSnapshot SimpleSamplerAudioProcessor::readParameters() const noexcept {
+    ParameterSnapshot snapshot;
+
+    snapshot.envelope.attack = mAttack->load();
+    snapshot.envelope.decay = mDecay->load();
+    snapshot.envelope.sustain = mSustain->load();
+    snapshot.envelope.release = mRelease->load();
+    snapshot.polyphony = static_cast<int>(mPolyphony->load());
+    snapshot.stealMode = static_cast<SamplerSynth::StealMode>(static_cast<int>(mStealMode->load()));
+    snapshot.quality = static_cast<ResamplingQuality>(static_cast<int>(mQuality->load()));
+
+    return snapshot;
+}
+
+juce::AudioProcessorValueTreeState::ParameterLayout SimpleSamplerAudioProcessor::createParameters() {
+    std::vector<std::unique_ptr<juce::RangedAudioParameter>> parameters;
+
+    parameters.push_back(std::make_unique<juce::AudioParameterFloat> ("ATTACK", "Attack", 0.0f, 5.0f, 0.0f));
+    parameters.push_back(std::make_unique<juce::AudioParameterFloat>("DECAY", "Decay", 0.0f, 5.0f, 0.0f));
+    parameters.push_back(std::make_unique<juce::AudioParameterFloat>("SUSTAIN", "Sustain", 0.0f, 5.0f, 0.0f));
+    parameters.push_back(std::make_unique<juce::AudioParameterFloat>("RELEASE", "Release", 0.0f, 5.0f, 0.0f));
+    parameters.push_back(std::make_unique<juce::AudioParameterInt>("POLYPHONY", "Polyphony", 1, 256, 64));
+    parameters.push_back(std::make_unique<juce::AudioParameterChoice>("STEAL_MODE", "Voice Stealing", juce::StringArray{ "Oldest", "Quietest", "Same Note" }, 0));
+    parameters.push_back(std::make_unique<juce::AudioParameterChoice>("QUALITY", "Resampling", juce::StringArray{ "Linear", "Cubic", "Sinc 8", "Sinc 32" }, 1));
+
+    return { parameters.begin(), parameters.end() };
+}
+
+//==============================================================================
+// This creates new instances of the plugin..
+juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
+{
+    return new SimpleSamplerAudioProcessor();
+}
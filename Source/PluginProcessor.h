@@ -1,91 +1,183 @@
-/*
-  ==============================================================================
-
-    This file contains the basic framework code for a JUCE plugin processor.
-
-  ==============================================================================
-*/
-
-#pragma once
-
-#include <JuceHeader.h>
-
-//==============================================================================
-/**
-*/
-class SimpleSamplerAudioProcessor  : public juce::AudioProcessor,
-                                     public juce::ValueTree::Listener
-{
-public:
-    //==============================================================================
-    SimpleSamplerAudioProcessor();
-    ~SimpleSamplerAudioProcessor() override;
-
-    //==============================================================================
-    void prepareToPlay (double sampleRate, int samplesPerBlock) override;
-    void releaseResources() override;
-
-   #ifndef JucePlugin_PreferredChannelConfigurations
-    bool isBusesLayoutSupported (const BusesLayout& layouts) const override;
-   #endif
-
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
-
-    //==============================================================================
-    juce::AudioProcessorEditor* createEditor() override;
-    bool hasEditor() const override;
-
-    //==============================================================================
-    const juce::String getName() const override;
-
-    bool acceptsMidi() const override;
-    bool producesMidi() const override;
-    bool isMidiEffect() const override;
-    double getTailLengthSeconds() const override;
-
-    //==============================================================================
-    int getNumPrograms() override;
-    int getCurrentProgram() override;
-    void setCurrentProgram (int index) override;
-    const juce::String getProgramName (int index) override;
-    void changeProgramName (int index, const juce::String& newName) override;
-
-    //==============================================================================
-    void getStateInformation (juce::MemoryBlock& destData) override;
-    void setStateInformation (const void* data, int sizeInBytes) override;
-
-    void loadFile();
-    void loadFile(const juce::String& path);
-    void setKeysAndSound();
-
-    int getNumSamplerSounds() { return mSampler.getNumSounds(); }
-    juce::AudioBuffer<float>& getWaveForm() { return mWaveForm; };
-
-    void updateADSR();
-
-    juce::ADSR::Parameters& getADSRParams() { return ADSRparams; }
-    juce::AudioProcessorValueTreeState& getAPVTS() { return APVTS; }
-    std::atomic<bool>& getIsNotePlayed() { return isNotePlayed; }
-    std::atomic<int>& getSampleCount() { return sampleCount; }
-
-private:
-    juce::Synthesiser mSampler;
-    const int mNumVoices{ 3 };
-    juce::AudioBuffer<float> mWaveForm;
-
-    juce::ADSR::Parameters ADSRparams;
-
-    juce::AudioFormatManager mFormatManager;
-    juce::AudioFormatReader* mFormatReader{ nullptr };
-
-    juce::AudioProcessorValueTreeState APVTS;
-    juce::AudioProcessorValueTreeState::ParameterLayout createParameters();
-    void valueTreePropertyChanged(juce::ValueTree& treeWhosePropertyHasChanged, const juce::Identifier& property) override;
-
-    std::atomic<bool> shouldUpdate { false };
-    std::atomic<bool> isNotePlayed { false };
-    std::atomic<int> sampleCount { 0 };
-
-    //==============================================================================
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SimpleSamplerAudioProcessor)
-};
+/*
+  ==============================================================================
+
+    This file contains the basic framework code for a JUCE plugin processor.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "SampleLoader.h"
+#include "DiskStreamer.h"
+#include "SamplerSynth.h"
+#include "PlayheadFifo.h"
+#include "LoadMonitor.h"
+#include "RenderWorkers.h"
+
+//==============================================================================
+/**
+*/
+class SimpleSamplerAudioProcessor  : public juce::AudioProcessor,
+                                     private juce::AsyncUpdater
+{
+public:
+    //==============================================================================
+    SimpleSamplerAudioProcessor();
+    ~SimpleSamplerAudioProcessor() override;
+
+    //==============================================================================
+    void prepareToPlay (double sampleRate, int samplesPerBlock) override;
+    void releaseResources() override;
+
+   #ifndef JucePlugin_PreferredChannelConfigurations
+    bool isBusesLayoutSupported (const BusesLayout& layouts) const override;
+   #endif
+
+    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+
+    //==============================================================================
+    juce::AudioProcessorEditor* createEditor() override;
+    bool hasEditor() const override;
+
+    //==============================================================================
+    const juce::String getName() const override;
+
+    bool acceptsMidi() const override;
+    bool producesMidi() const override;
+    bool isMidiEffect() const override;
+    double getTailLengthSeconds() const override;
+
+    //==============================================================================
+    int getNumPrograms() override;
+    int getCurrentProgram() override;
+    void setCurrentProgram (int index) override;
+    const juce::String getProgramName (int index) override;
+    void changeProgramName (int index, const juce::String& newName) override;
+
+    //==============================================================================
+    void getStateInformation (juce::MemoryBlock& destData) override;
+    void setStateInformation (const void* data, int sizeInBytes) override;
+
+    void loadFile();
+    void loadFile(const juce::String& path);
+    void loadZones(const std::vector<SampleZone>& zones);
+
+    // Loads dropped files and folders as a kit, one key per file from C1
+    // upwards. A single file is spread across the whole keyboard instead.
+    void importFiles(const juce::StringArray& paths);
+    bool canImport(const juce::File& file);
+
+    // Saves the loaded keymap and the current parameters as a kit file on a
+    // background thread, one export at a time. onFinished is called on the
+    // message thread with whether the kit was written, unless the export was
+    // cancelled. Returns false if there's nothing to export or an export is
+    // already running.
+    bool exportKit(const juce::File& file, std::function<void (bool)> onFinished);
+
+    bool isExporting() const { return mExporting; }
+    double getExportProgress() const { return mExportProgress; }
+    void cancelExport() { mExportCancelled = true; }
+
+    bool isLoading() const { return mLoader.isLoading(); }
+    double getLoadProgress() const { return mLoader.getProgress(); }
+    void cancelLoading() { mLoader.cancel(); }
+
+    void setStreamingEnabled(bool shouldStream) { mLoader.setStreamingEnabled(shouldStream); }
+    void setMemoryMappingEnabled(bool shouldMap) { mLoader.setMemoryMappingEnabled(shouldMap); }
+    void setDecodedCacheEnabled(bool shouldCache) { mLoader.setDecodedCacheEnabled(shouldCache); }
+    void setCompactEncodingEnabled(bool shouldEncode) { mLoader.setCompactEncodingEnabled(shouldEncode); }
+    void setLazyLoadingEnabled(bool shouldLoadLazily) { mLoader.setLazyLoadingEnabled(shouldLoadLazily); }
+    void setOnsetTrimmingEnabled(bool shouldTrim) { mLoader.setOnsetTrimmingEnabled(shouldTrim); }
+
+    // Extra threads that share the voices with the audio thread. Takes effect
+    // the next time the host prepares the plugin; 0, the default, renders
+    // every voice on the audio thread.
+    void setNumRenderThreads(int numThreads) { mNumRenderThreads = juce::jlimit(0, VoiceBank::maxPartitions - 1, numThreads); }
+
+    int getNumSamplerSounds() { return mSampler.getNumSounds(); }
+    LoadedSample::Ptr getLoadedSample() const;
+
+    juce::AudioProcessorValueTreeState& getAPVTS() { return APVTS; }
+    PlayheadFifo& getPlayheads() { return mPlayheads; }
+
+    // Safe to read from any thread, e.g. for logging from the host side.
+    const LoadMonitor& getLoadMonitor() const { return mLoadMonitor; }
+
+private:
+    DiskStreamer mStreamer;
+    RenderWorkers mWorkers;
+    SamplerSynth mSampler{ mStreamer };
+    std::atomic<int> mNumRenderThreads { 0 };
+
+    juce::AudioFormatManager mFormatManager;
+    SampleLoader mLoader;
+
+    void requestZones(const std::vector<SampleZone>& zones, bool applyKitParameters);
+    void sampleLoaded(LoadedSample::Ptr sample);
+    void takePendingSound();
+
+    // Applies a loaded kit's parameters on the message thread.
+    void handleAsyncUpdate() override;
+
+    static std::vector<SampleZone> createKitZones(const juce::Array<juce::File>& files);
+
+    juce::ValueTree createZoneState() const;
+    static std::vector<SampleZone> readZoneState(const juce::ValueTree& state);
+
+    // The zones the session should hold: the last ones asked for, with their
+    // content hashes once loaded. Saved even if loading hasn't finished yet.
+    mutable juce::CriticalSection mSessionLock;
+    std::vector<SampleZone> mSessionZones;
+
+    // A kit opened by the user brings its parameters along once it has
+    // loaded. Sessions that use a kit restore their own instead. Both are
+    // guarded by mSessionLock.
+    bool mApplyKitParameters = false;
+    juce::ValueTree mPendingKitParameters;
+
+    // Written by the loader thread and read by the GUI.
+    mutable juce::SpinLock mLoadedSampleLock;
+    LoadedSample::Ptr mLoadedSample;
+
+    // Holds one reference on the sound until processBlock adopts it.
+    std::atomic<juce::SynthesiserSound*> mPendingSound { nullptr };
+
+    juce::AudioProcessorValueTreeState APVTS;
+    juce::AudioProcessorValueTreeState::ParameterLayout createParameters();
+
+    std::atomic<bool> mExporting { false };
+    std::atomic<bool> mExportCancelled { false };
+    std::atomic<double> mExportProgress { 0.0 };
+
+    // Everything the audio thread needs from the APVTS, read once per block.
+    struct ParameterSnapshot
+    {
+        juce::ADSR::Parameters envelope;
+        int polyphony = 64;
+        SamplerSynth::StealMode stealMode = SamplerSynth::StealMode::oldest;
+        ResamplingQuality quality = ResamplingQuality::cubic;
+    };
+
+    ParameterSnapshot readParameters() const noexcept;
+
+    std::atomic<float>* mAttack = nullptr;
+    std::atomic<float>* mDecay = nullptr;
+    std::atomic<float>* mSustain = nullptr;
+    std::atomic<float>* mRelease = nullptr;
+    std::atomic<float>* mPolyphony = nullptr;
+    std::atomic<float>* mStealMode = nullptr;
+    std::atomic<float>* mQuality = nullptr;
+
+    // Filled after every block for the thumbnail's playheads.
+    PlayheadFifo mPlayheads;
+
+    LoadMonitor mLoadMonitor;
+
+    // Last, so a running export is stopped before anything it uses goes.
+    juce::ThreadPool mExportPool { 1 };
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SimpleSamplerAudioProcessor)
+};
@@ -0,0 +1,161 @@
+/*
+  ==============================================================================
+
+    RenderWorkers.cpp
+    Created: 17 Oct 2026 8:36:51pm
+    Author:  tmobr
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "RenderWorkers.h"
+
+//==============================================================================
+class RenderWorkers::Worker  : public juce::Thread
+{
+public:
+    Worker(RenderWorkers& ownerToUse, int index)
+        : juce::Thread("Render Worker " + juce::String(index + 1)), owner(ownerToUse)
+    {
+    }
+
+    void run() override {
+        auto seen = owner.mGeneration.load();
+        auto lastJob = juce::Time::getMillisecondCounter();
+
+        while (!threadShouldExit()) {
+            auto generation = owner.mGeneration.load();
+
+            if (generation != seen) {
+                seen = generation;
+
+                while (owner.renderNextPartition()) {
+                }
+
+                lastJob = juce::Time::getMillisecondCounter();
+                continue;
+            }
+
+            // Blocks arrive every few milliseconds while playing, so spin for
+            // a little while before paying for a sleep and a wake-up.
+            if (juce::Time::getMillisecondCounter() - lastJob < spinMilliseconds) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            // The generation is checked again after announcing the sleep, so a
+            // job posted in between is never missed.
+            sleeping = true;
+
+            if (owner.mGeneration.load() == seen) {
+                wait(-1);
+            }
+
+            sleeping = false;
+        }
+    }
+
+    std::atomic<bool> sleeping { false };
+
+private:
+    static constexpr juce::uint32 spinMilliseconds = 2;
+
+    RenderWorkers& owner;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Worker)
+};
+
+//==============================================================================
+RenderWorkers::RenderWorkers()
+{
+}
+
+RenderWorkers::~RenderWorkers()
+{
+    setNumThreads(0);
+}
+
+void RenderWorkers::setNumThreads(int numThreads, double sampleRate, int blockSize) {
+    numThreads = juce::jmax(0, numThreads);
+
+    if (numThreads == mWorkers.size() && sampleRate == mSampleRate && blockSize == mBlockSize) {
+        return;
+    }
+
+    mSampleRate = sampleRate;
+    mBlockSize = blockSize;
+
+    for (auto* worker : mWorkers) {
+        worker->signalThreadShouldExit();
+        worker->notify();
+    }
+
+    for (auto* worker : mWorkers) {
+        worker->stopThread(1000);
+    }
+
+    mWorkers.clear();
+
+    // Realtime scheduling keeps the OS from preempting a worker halfway
+    // through a partition the audio thread is waiting on. Where it isn't
+    // granted, the highest ordinary priority is the next best thing.
+    auto options = juce::Thread::RealtimeOptions().withPriority(10);
+
+    if (sampleRate > 0.0 && blockSize > 0) {
+        options = options.withApproximateAudioProcessingTime(blockSize, sampleRate);
+    }
+
+    for (int i = 0; i < numThreads; ++i) {
+        auto* worker = mWorkers.add(new Worker(*this, i));
+
+        if (!worker->startRealtimeThread(options) && !worker->isThreadRunning()) {
+            worker->startThread(juce::Thread::Priority::highest);
+        }
+    }
+}
+
+void RenderWorkers::perform(Job& job, int numPartitions) noexcept {
+    if (numPartitions <= 0) {
+        return;
+    }
+
+    mJob.store(&job);
+    mNumRemaining.store(numPartitions);
+    mTickets.store(static_cast<juce::uint64>(numPartitions) << countShift);
+    mGeneration.fetch_add(1);
+
+    for (auto* worker : mWorkers) {
+        if (worker->sleeping.load()) {
+            worker->notify();
+        }
+    }
+
+    // Claims every partition no worker has got to yet, rather than waiting
+    // for one to wake up and take it.
+    while (renderNextPartition()) {
+    }
+
+    // What's left is already being rendered on a realtime worker, and
+    // finishes well within a block.
+    while (mNumRemaining.load() > 0) {
+        std::this_thread::yield();
+    }
+}
+
+bool RenderWorkers::renderNextPartition() noexcept {
+    const auto ticket = mTickets.fetch_add(1);
+    const auto index = static_cast<int>(ticket & 0xffffffff);
+    const auto count = static_cast<int>(ticket >> countShift);
+
+    if (index >= count) {
+        return false;
+    }
+
+    // The job can't have changed: perform() doesn't return, and so can't be
+    // called again, until this partition is done.
+    mJob.load()->renderPartition(index);
+    mNumRemaining.fetch_sub(1);
+
+    return true;
+}
@@ -0,0 +1,66 @@
+/*
+  ==============================================================================
+
+    RenderWorkers.h
+    Created: 17 Oct 2026 8:36:51pm
+    Author:  tmobr
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/*
+    A small pool of realtime threads that help the audio thread through jobs
+    split into partitions. The calling thread takes every partition no worker
+    has claimed yet, so a job always finishes even if no worker wakes up in
+    time; it only ever waits for partitions a worker is already rendering.
+
+    Partitions are handed out from one atomic counter, so nothing on the audio
+    thread takes a lock. Idle workers sleep, and are only woken, with a single
+    signal, when a job arrives while they're asleep.
+*/
+class RenderWorkers
+{
+public:
+    struct Job
+    {
+        virtual ~Job() = default;
+        virtual void renderPartition(int partition) noexcept = 0;
+    };
+
+    RenderWorkers();
+    ~RenderWorkers();
+
+    // Starts and stops threads, so only call this while the audio thread is
+    // stopped. The sample rate and block size tell the OS how often, and for
+    // how long, the workers need the CPU.
+    void setNumThreads(int numThreads, double sampleRate = 0.0, int blockSize = 0);
+    int getNumThreads() const noexcept { return mWorkers.size(); }
+
+    // Audio thread. Returns once every partition has been rendered.
+    void perform(Job& job, int numPartitions) noexcept;
+
+private:
+    class Worker;
+
+    // The next partition index in the low 32 bits and the job's partition
+    // count above them, so one fetch_add says whether there's work left.
+    static constexpr int countShift = 32;
+
+    bool renderNextPartition() noexcept;
+
+    juce::OwnedArray<Worker> mWorkers;
+    double mSampleRate = 0.0;
+    int mBlockSize = 0;
+
+    std::atomic<Job*> mJob { nullptr };
+    std::atomic<juce::uint64> mTickets { 0 };
+    std::atomic<int> mNumRemaining { 0 };
+    std::atomic<juce::uint32> mGeneration { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RenderWorkers)
+};
@@ -0,0 +1,137 @@
+/*
+  ==============================================================================
+
+    Resampling.h
+    Created: 17 Oct 2026 9:51:18pm
+    Author:  tmobr
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <cmath>
+
+//==============================================================================
+enum class ResamplingQuality
+{
+    linear,
+    cubic,
+    sinc8,
+    sinc32
+};
+
+//==============================================================================
+/*
+    Kaiser-windowed sinc tables for the polyphase resamplers, built once on
+    first use; they are far too big to build within compilers' constant
+    evaluation limits. Each table holds one row of taps per fractional phase,
+    plus a final row for a phase of exactly one so neighbouring rows can always
+    be interpolated.
+
+    Transposing up needs a lower cutoff to stay alias-free, so every tap count
+    has a table per half-octave band of pitch ratio, up to two octaves up.
+    Beyond that the top band is used and some aliasing returns.
+*/
+namespace Resampling
+{
+    constexpr int numPhases = 64;
+    constexpr int numBands = 5;
+
+    // Relative to the source's Nyquist frequency.
+    constexpr double passband = 0.92;
+    constexpr double bandRatios[numBands] = { 1.0, 1.4142135623730951, 2.0, 2.8284271247461903, 4.0 };
+
+    inline int getBand(double pitchRatio) noexcept
+    {
+        int band = 0;
+
+        while (band < numBands - 1 && pitchRatio > bandRatios[band]) {
+            ++band;
+        }
+
+        return band;
+    }
+
+    template <int numTaps>
+    struct SincTable
+    {
+        float coefficients[numPhases + 1][numTaps];
+    };
+
+    template <int numTaps>
+    struct SincTableSet
+    {
+        SincTable<numTaps> bands[numBands];
+    };
+
+    namespace detail
+    {
+        constexpr double pi = 3.14159265358979323846;
+
+        // The zeroth-order modified Bessel function, taking x squared so the
+        // Kaiser window needs no square root.
+        inline double besselI0(double xSquared)
+        {
+            double term = 1.0, sum = 1.0;
+
+            for (int k = 1; k < 40; ++k) {
+                term *= xSquared / (4.0 * k * k);
+                sum += term;
+            }
+
+            return sum;
+        }
+
+        template <int numTaps>
+        void makeSincTable(SincTable<numTaps>& table, double cutoff)
+        {
+            constexpr double beta = numTaps >= 32 ? 10.0 : 6.0;
+            constexpr double halfWidth = numTaps / 2;
+
+            const double windowScale = 1.0 / besselI0(beta * beta);
+
+            for (int phase = 0; phase <= numPhases; ++phase) {
+                const double fraction = static_cast<double>(phase) / numPhases;
+                double coefficients[numTaps] {};
+                double sum = 0.0;
+
+                for (int tap = 0; tap < numTaps; ++tap) {
+                    const double t = (tap - (numTaps / 2 - 1)) - fraction;
+                    const double r = t / halfWidth;
+                    const double window = r * r < 1.0 ? besselI0(beta * beta * (1.0 - r * r)) * windowScale : 0.0;
+                    const double x = pi * cutoff * t;
+
+                    coefficients[tap] = window * (x == 0.0 ? 1.0 : std::sin(x) / x);
+                    sum += coefficients[tap];
+                }
+
+                // Unity gain at DC for every phase, so the cutoff can't leave ripple.
+                for (int tap = 0; tap < numTaps; ++tap) {
+                    table.coefficients[phase][tap] = static_cast<float>(coefficients[tap] / sum);
+                }
+            }
+        }
+
+        template <int numTaps>
+        SincTableSet<numTaps> makeSincTables()
+        {
+            SincTableSet<numTaps> tables {};
+
+            for (int band = 0; band < numBands; ++band) {
+                makeSincTable(tables.bands[band], passband / bandRatios[band]);
+            }
+
+            return tables;
+        }
+    }
+
+    // Built on first use. VoiceBank asks for every table in its constructor,
+    // so they're never built on the audio thread.
+    template <int numTaps>
+    const SincTableSet<numTaps>& getSincTables()
+    {
+        static const auto tables = detail::makeSincTables<numTaps>();
+        return tables;
+    }
+}
@@ -0,0 +1,343 @@
+/*
+  ==============================================================================
+
+    SampleData.cpp
+    Created: 17 Oct 2026 5:48:30pm
+    Author:  tmobr
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "SampleData.h"
+#include "Float4.h"
+
+//==============================================================================
+namespace
+{
+    // The scales JUCE's readers use, so encoding and decoding are exact.
+    constexpr float int16Scale = 1.0f / 32768.0f;
+    constexpr float int24Scale = 1.0f / 8388608.0f;
+
+    juce::int32 unpackInt24(const juce::uint8* p) noexcept
+    {
+        return static_cast<juce::int32>(static_cast<juce::uint32>(p[0]) << 8
+                                      | static_cast<juce::uint32>(p[1]) << 16
+                                      | static_cast<juce::uint32>(p[2]) << 24) >> 8;
+    }
+
+    void convertInt16(const juce::int16* source, float* dest, int numSamples) noexcept
+    {
+        const auto scale = Float4::broadcast(int16Scale);
+        int i = 0;
+
+        for (; i + 4 <= numSamples; i += 4) {
+            (Float4::fromInt16(source + i) * scale).store(dest + i);
+        }
+
+        for (; i < numSamples; ++i) {
+            dest[i] = static_cast<float>(source[i]) * int16Scale;
+        }
+    }
+
+    void convertInt24(const juce::uint8* source, float* dest, int numSamples) noexcept
+    {
+        const auto scale = Float4::broadcast(int24Scale);
+        int i = 0;
+
+        for (; i + 4 <= numSamples; i += 4) {
+            const juce::int32 values[] = { unpackInt24(source + 3 * i), unpackInt24(source + 3 * i + 3),
+                                           unpackInt24(source + 3 * i + 6), unpackInt24(source + 3 * i + 9) };
+
+            (Float4::fromInt32(values) * scale).store(dest + i);
+        }
+
+        for (; i < numSamples; ++i) {
+            dest[i] = static_cast<float>(unpackInt24(source + 3 * i)) * int24Scale;
+        }
+    }
+}
+
+//==============================================================================
+SampleData::SampleData(const juce::File& sourceFile, const juce::String& sourceHash, juce::AudioFormatReader& source, juce::int64 numSamplesToPreload,
+                       std::unique_ptr<juce::MemoryMappedAudioFormatReader> mappedSource,
+                       const juce::File& decodedFile)
+    : name(sourceFile.getFileNameWithoutExtension()),
+      file(sourceFile),
+      audioFile(decodedFile),
+      contentHash(sourceHash),
+      sourceSampleRate(source.sampleRate),
+      length(source.lengthInSamples),
+      mapped(std::move(mappedSource))
+{
+    if (sourceSampleRate > 0 && length > 0) {
+        auto numPreloaded = static_cast<int>(juce::jmin(length, numSamplesToPreload));
+
+        data.setSize(juce::jmin(2, static_cast<int>(source.numChannels)), numPreloaded);
+        source.read(&data, 0, numPreloaded, 0, true, true);
+    }
+
+    numPreloaded = data.getNumSamples();
+    numChannels = data.getNumChannels();
+    endFrame = length;
+
+    for (int channel = 0; channel < numChannels; ++channel) {
+        channels[channel] = data.getReadPointer(channel);
+    }
+}
+
+SampleData::SampleData(const juce::File& sourceFile, const juce::String& sourceHash, double sampleRate, int numFrames, int numSourceChannels,
+                       Encoding storedEncoding, std::shared_ptr<const juce::MemoryMappedFile> kitMapping, size_t offset)
+    : name(sourceFile.getFileNameWithoutExtension()),
+      file(sourceFile),
+      contentHash(sourceHash),
+      encoding(storedEncoding),
+      numPreloaded(numFrames),
+      numChannels(juce::jlimit(1, 2, numSourceChannels)),
+      sourceSampleRate(sampleRate),
+      length(numFrames),
+      endFrame(numFrames),
+      kit(std::move(kitMapping))
+{
+    const auto* start = static_cast<const juce::uint8*>(kit->getData()) + offset;
+    const auto channelSize = static_cast<size_t>(numPreloaded) * getBytesPerSample(encoding);
+
+    for (int channel = 0; channel < numChannels; ++channel) {
+        channels[channel] = start + static_cast<size_t>(channel) * channelSize;
+    }
+}
+
+SampleData::~SampleData()
+{
+}
+
+// Hashing the length plus the head and tail of the file is enough to tell
+// files apart without reading gigabytes of audio while a session opens.
+juce::String SampleData::computeContentHash(const juce::File& file) {
+    juce::FileInputStream stream(file);
+
+    if (!stream.openedOk()) {
+        return {};
+    }
+
+    const auto size = stream.getTotalLength();
+    const auto span = juce::jmin(size, static_cast<juce::int64>(hashSpan));
+
+    juce::MemoryOutputStream bytes;
+    bytes.writeInt64(size);
+    bytes.writeFromInputStream(stream, span);
+
+    if (size > span) {
+        stream.setPosition(size - span);
+        bytes.writeFromInputStream(stream, span);
+    }
+
+    return juce::MD5(bytes.getData(), bytes.getDataSize()).toHexString();
+}
+
+void SampleData::encode(Encoding newEncoding) {
+    if (encoding != Encoding::float32 || newEncoding == Encoding::float32 || kit != nullptr) {
+        return;
+    }
+
+    const auto channelSize = static_cast<size_t>(numPreloaded) * getBytesPerSample(newEncoding);
+    encoded.resize(channelSize * static_cast<size_t>(numChannels));
+
+    for (int channel = 0; channel < numChannels; ++channel) {
+        auto* dest = encoded.data() + static_cast<size_t>(channel) * channelSize;
+
+        encodeSamples(data.getReadPointer(channel), dest, numPreloaded, newEncoding);
+        channels[channel] = dest;
+    }
+
+    encoding = newEncoding;
+    data.setSize(0, 0);
+}
+
+void SampleData::setTrim(juce::int64 newStartFrame, juce::int64 newEndFrame) {
+    endFrame = juce::jlimit(static_cast<juce::int64>(1), juce::jmax(static_cast<juce::int64>(1), length), newEndFrame);
+    startFrame = juce::jlimit(static_cast<juce::int64>(0), endFrame - 1, newStartFrame);
+}
+
+void SampleData::touchKitPages(juce::int64 numFrames) const noexcept {
+    if (kit == nullptr) {
+        return;
+    }
+
+    constexpr size_t pageSize = 4096;
+    const auto bytesPerSample = getBytesPerSample(encoding);
+    const auto first = static_cast<size_t>(juce::jmin(startFrame, static_cast<juce::int64>(numPreloaded))) * bytesPerSample;
+    const auto last = static_cast<size_t>(juce::jmin(startFrame + numFrames, static_cast<juce::int64>(numPreloaded))) * bytesPerSample;
+
+    for (int channel = 0; channel < numChannels; ++channel) {
+        // Volatile so the reads can't be optimised away.
+        const auto* bytes = static_cast<const volatile juce::uint8*>(channels[channel]);
+
+        for (auto i = first; i < last; i += pageSize) {
+            [[maybe_unused]] const juce::uint8 byte = bytes[i];
+        }
+    }
+}
+
+void SampleData::trimSilence() {
+    if (encoding != Encoding::float32 || numPreloaded == 0) {
+        return;
+    }
+
+    float peak = 0.0f;
+
+    if (!peaks.isEmpty()) {
+        const auto whole = peaks.getPeak(0, length);
+        peak = juce::jmax(whole.max, -whole.min);
+    }
+    else {
+        for (int channel = 0; channel < numChannels; ++channel) {
+            const auto range = juce::FloatVectorOperations::findMinAndMax(getPreloadedChannel(channel), numPreloaded);
+            peak = juce::jmax(peak, range.getEnd(), -range.getStart());
+        }
+    }
+
+    const auto threshold = juce::jmax(silenceFloor, peak * silenceBelowPeak);
+    const auto onset = findOnset(threshold);
+
+    // A head that's quiet throughout is left alone rather than searched past,
+    // since anything beyond it isn't in memory.
+    if (onset < 0) {
+        return;
+    }
+
+    const auto end = peaks.isEmpty() ? length : peaks.findEndAbove(threshold);
+    setTrim(findZeroCrossingBefore(onset), juce::jmax(end, onset + 1));
+}
+
+// Whole chunks are ruled out with the vectorised min/max search, and only the
+// chunk holding the onset is looked at frame by frame.
+juce::int64 SampleData::findOnset(float threshold) const noexcept {
+    for (int start = 0; start < numPreloaded; start += onsetChunkSize) {
+        const auto numFrames = juce::jmin(onsetChunkSize, numPreloaded - start);
+        bool loud = false;
+
+        for (int channel = 0; channel < numChannels && !loud; ++channel) {
+            const auto range = juce::FloatVectorOperations::findMinAndMax(getPreloadedChannel(channel) + start, numFrames);
+            loud = range.getEnd() > threshold || -range.getStart() > threshold;
+        }
+
+        if (!loud) {
+            continue;
+        }
+
+        for (int i = start; i < start + numFrames; ++i) {
+            for (int channel = 0; channel < numChannels; ++channel) {
+                if (std::abs(getPreloadedChannel(channel)[i]) > threshold) {
+                    return i;
+                }
+            }
+        }
+    }
+
+    return -1;
+}
+
+// Starting on a zero crossing of the channels' sum keeps the first frame a
+// voice plays from clicking. Failing one nearby, the quietest frame will do.
+juce::int64 SampleData::findZeroCrossingBefore(juce::int64 frame) const noexcept {
+    auto sum = [this] (juce::int64 i) {
+        float total = 0.0f;
+
+        for (int channel = 0; channel < numChannels; ++channel) {
+            total += getPreloadedChannel(channel)[i];
+        }
+
+        return total;
+    };
+
+    const auto lowest = juce::jmax(static_cast<juce::int64>(0), frame - zeroCrossingSearch);
+    auto quietest = frame;
+
+    for (auto i = frame; i > lowest; --i) {
+        const auto current = sum(i), previous = sum(i - 1);
+
+        if (current == 0.0f || (current > 0.0f) != (previous > 0.0f)) {
+            return std::abs(previous) < std::abs(current) ? i - 1 : i;
+        }
+
+        if (std::abs(previous) < std::abs(sum(quietest))) {
+            quietest = i - 1;
+        }
+    }
+
+    return quietest;
+}
+
+size_t SampleData::getBytesPerSample(Encoding sampleEncoding) noexcept {
+    switch (sampleEncoding) {
+        case Encoding::int16: return 2;
+        case Encoding::int24: return 3;
+        default:              return sizeof(float);
+    }
+}
+
+void SampleData::encodeSamples(const float* source, void* dest, int numSamples, Encoding sampleEncoding) noexcept {
+    if (sampleEncoding == Encoding::float32) {
+        std::copy_n(source, numSamples, static_cast<float*>(dest));
+        return;
+    }
+
+    for (int i = 0; i < numSamples; ++i) {
+        if (sampleEncoding == Encoding::int16) {
+            static_cast<juce::int16*>(dest)[i] = static_cast<juce::int16>(juce::jlimit(-32768, 32767, juce::roundToInt(source[i] * 32768.0f)));
+        }
+        else {
+            const auto value = juce::jlimit(-8388608, 8388607, juce::roundToInt(source[i] * 8388608.0f));
+            auto* packed = static_cast<juce::uint8*>(dest) + 3 * i;
+
+            packed[0] = static_cast<juce::uint8>(value);
+            packed[1] = static_cast<juce::uint8>(value >> 8);
+            packed[2] = static_cast<juce::uint8>(value >> 16);
+        }
+    }
+}
+
+const float* SampleData::getPreloadedChannel(int channel) const noexcept {
+    if (encoding != Encoding::float32 || numChannels == 0) {
+        return nullptr;
+    }
+
+    return static_cast<const float*>(channels[juce::jmin(channel, numChannels - 1)]);
+}
+
+void SampleData::readPreloaded(int startFrame, int numFrames, float* left, float* right) const noexcept {
+    jassert(startFrame >= 0 && startFrame + numFrames <= numPreloaded);
+
+    for (int channel = 0; channel < 2; ++channel) {
+        const auto* source = channels[juce::jmin(channel, numChannels - 1)];
+        auto* dest = channel == 0 ? left : right;
+
+        switch (encoding) {
+            case Encoding::float32: std::copy_n(static_cast<const float*>(source) + startFrame, numFrames, dest);                  break;
+            case Encoding::int16:   convertInt16(static_cast<const juce::int16*>(source) + startFrame, dest, numFrames);           break;
+            case Encoding::int24:   convertInt24(static_cast<const juce::uint8*>(source) + 3 * startFrame, dest, numFrames);       break;
+        }
+    }
+}
+
+int SampleData::readMapped(juce::int64 startFrame, int numFrames, float* left, float* right) const noexcept {
+    jassert(mapped != nullptr);
+
+    numFrames = static_cast<int>(juce::jlimit(static_cast<juce::int64>(0), static_cast<juce::int64>(numFrames), length - startFrame));
+
+    if (numFrames <= 0) {
+        return 0;
+    }
+
+    float* const channels[] = { left, right };
+    const auto numChannels = juce::jmin(2, static_cast<int>(mapped->numChannels));
+
+    mapped->read(channels, numChannels, startFrame, numFrames);
+
+    if (numChannels == 1) {
+        std::copy(left, left + numFrames, right);
+    }
+
+    return numFrames;
+}
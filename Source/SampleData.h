@@ -0,0 +1,154 @@
+/*
+  ==============================================================================
+
+    SampleData.h
+    Created: 17 Oct 2026 5:48:30pm
+    Author:  tmobr
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PeakPyramid.h"
+
+//==============================================================================
+/*
+    The audio of one file and the peaks the thumbnail draws from it, shared by
+    every zone that plays the file and by the thumbnail.
+
+    Short files are decoded into memory in full. Long ones keep only a
+    preloaded head in memory and have the rest streamed from disk by the
+    playing voice. Uncompressed files can instead be memory-mapped: the head
+    is still decoded up front so attacks never touch the mapping, and the rest
+    is converted straight from the mapped file pages, which the OS shares
+    between plugin instances.
+
+    Preloaded audio from 16- and 24-bit sources can be held in its original
+    width rather than as floats, which halves or quarters the memory taken.
+    It converts back exactly, a few frames at a time, as voices read it.
+
+    Samples from a kit file are preloaded in full without being decoded:
+    their frames are the kit's own mapped pages, in whatever encoding the kit
+    stored them. Only the pages of the head are read up front.
+
+    It is built once by the loader and never changes after that.
+*/
+class SampleData  : public juce::ReferenceCountedObject
+{
+public:
+    using Ptr = juce::ReferenceCountedObjectPtr<SampleData>;
+
+    enum class Encoding
+    {
+        float32,
+        int16,
+        int24   // packed, three bytes a sample
+    };
+
+    // The hash is the source's computeContentHash(), which the loader has
+    // already worked out by the time it decodes.
+    SampleData(const juce::File& sourceFile, const juce::String& sourceHash, juce::AudioFormatReader& source, juce::int64 numSamplesToPreload,
+               std::unique_ptr<juce::MemoryMappedAudioFormatReader> mappedSource = nullptr,
+               const juce::File& decodedFile = {});
+
+    // Plays frames stored in a kit, starting at the given offset into its
+    // mapping, which is kept open for as long as the sample lives.
+    SampleData(const juce::File& sourceFile, const juce::String& sourceHash, double sampleRate, int numFrames, int numSourceChannels,
+               Encoding storedEncoding, std::shared_ptr<const juce::MemoryMappedFile> kitMapping, size_t offset);
+    ~SampleData() override;
+
+    const juce::String& getName() const noexcept { return name; }
+    const juce::File& getFile() const noexcept { return file; }
+
+    // The file the audio is actually read from: the source itself, or its
+    // decoded copy when the source is compressed and cached.
+    const juce::File& getAudioFile() const noexcept { return audioFile != juce::File() ? audioFile : file; }
+
+    int getNumPreloadedSamples() const noexcept { return numPreloaded; }
+    int getNumChannels() const noexcept { return numChannels; }
+    Encoding getEncoding() const noexcept { return encoding; }
+
+    // Float data only, so voices can read it in place; nullptr once encoded.
+    // Mono data returns its one channel for both.
+    const float* getPreloadedChannel(int channel) const noexcept;
+
+    // Converts preloaded frames into two channels, whatever the encoding.
+    void readPreloaded(int startFrame, int numFrames, float* left, float* right) const noexcept;
+
+    juce::int64 getLengthInSamples() const noexcept { return length; }
+    bool isStreaming() const noexcept { return !isMemoryMapped() && getNumPreloadedSamples() < length; }
+    bool isMemoryMapped() const noexcept { return mapped != nullptr; }
+
+    // Where voices start and stop playing, past any near-silence at either
+    // end. The whole sample unless it has been trimmed.
+    juce::int64 getStartFrame() const noexcept { return startFrame; }
+    juce::int64 getEndFrame() const noexcept { return endFrame; }
+    double getSourceSampleRate() const noexcept { return sourceSampleRate; }
+
+    // Identifies the file's contents across paths and sessions.
+    const juce::String& getContentHash() const noexcept { return contentHash; }
+    static juce::String computeContentHash(const juce::File& file);
+
+    // Converts frames from the mapping into two channels, returning how many
+    // were available. Mapped data only; the mapped reader keeps no read
+    // position, so render workers may call this at the same time.
+    int readMapped(juce::int64 startFrame, int numFrames, float* left, float* right) const noexcept;
+
+    // Only called by the loader, before the data is handed to anyone else.
+    void encode(Encoding newEncoding);
+    void setTrim(juce::int64 newStartFrame, juce::int64 newEndFrame);
+
+    // Reads a byte from every page of a kit sample's frames from the start
+    // onwards, so the first note doesn't wait on page faults. Does nothing for
+    // samples that don't play from a kit.
+    void touchKitPages(juce::int64 numFrames) const noexcept;
+
+    // Finds the onset in the preloaded audio and starts at the zero crossing
+    // just before it, and ends where the peaks last rise above the same
+    // threshold. Needs float data, so it comes before encode(); without peaks
+    // only the start is trimmed.
+    void trimSilence();
+
+    // How frames are stored in memory and in kits, one channel after another.
+    static size_t getBytesPerSample(Encoding sampleEncoding) noexcept;
+    static void encodeSamples(const float* source, void* dest, int numSamples, Encoding sampleEncoding) noexcept;
+
+    PeakPyramid& getPeaks() noexcept { return peaks; }
+    const PeakPyramid& getPeaks() const noexcept { return peaks; }
+
+private:
+    // Bytes hashed from each end of the file.
+    static constexpr int hashSpan = 1 << 16;
+
+    juce::int64 findOnset(float threshold) const noexcept;
+    juce::int64 findZeroCrossingBefore(juce::int64 frame) const noexcept;
+
+    // Silence is judged against the sample's own peak, so quiet recordings
+    // keep their soft attacks, but nothing under the floor ever counts as sound.
+    static constexpr float silenceBelowPeak = 0.003f;    // -50 dB
+    static constexpr float silenceFloor = 1.0e-4f;       // -80 dB
+    static constexpr int onsetChunkSize = 64;
+    static constexpr int zeroCrossingSearch = 512;
+
+    juce::String name;
+    juce::File file, audioFile;
+    juce::String contentHash;
+    juce::AudioBuffer<float> data;
+    std::vector<juce::uint8> encoded;
+
+    // Where each channel's preloaded frames start: in data, in encoded, or in
+    // a kit's mapping.
+    const void* channels[2] = {};
+
+    Encoding encoding = Encoding::float32;
+    int numPreloaded = 0, numChannels = 0;
+    double sourceSampleRate = 0.0;
+    juce::int64 length = 0, startFrame = 0, endFrame = 0;
+    std::unique_ptr<juce::MemoryMappedAudioFormatReader> mapped;
+    std::shared_ptr<const juce::MemoryMappedFile> kit;
+    PeakPyramid peaks;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SampleData)
+};
@@ -0,0 +1,102 @@
+/*
+  ==============================================================================
+
+    SampleKeymap.cpp
+    Created: 17 Oct 2026 6:02:14pm
+    Author:  tmobr
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "SampleKeymap.h"
+
+//==============================================================================
+SampleKeymap::SampleKeymap(const juce::ReferenceCountedArray<SampleSound>& zonesToUse)
+    : mZones(zonesToUse)
+{
+    buildTable();
+}
+
+SampleKeymap::~SampleKeymap()
+{
+}
+
+void SampleKeymap::buildTable() {
+    mCells.assign(128 * 128, {});
+    mEntries.clear();
+    mZoneIndices.clear();
+    mMappedKeys.clear();
+
+    std::vector<int> covering, previous, groups;
+
+    for (int note = 0; note < 128; ++note) {
+        for (int velocity = 0; velocity < 128; ++velocity) {
+            const auto index = static_cast<size_t>(note * 128 + velocity);
+            auto& cell = mCells[index];
+
+            covering.clear();
+
+            for (int i = 0; i < mZones.size(); ++i) {
+                const auto& zone = mZones.getUnchecked(i)->getZone();
+
+                if (note >= zone.lowKey && note <= zone.highKey
+                     && velocity >= zone.lowVelocity && velocity <= zone.highVelocity) {
+                    covering.push_back(i);
+                }
+            }
+
+            if (covering.empty()) {
+                previous.clear();
+                continue;
+            }
+
+            mMappedKeys.setBit(note);
+
+            // Cells are visited in table order, so previous is always the one before.
+            if (covering == previous) {
+                cell = mCells[index - 1];
+                continue;
+            }
+
+            cell.firstEntry = static_cast<int>(mEntries.size());
+            groups.clear();
+
+            for (auto i : covering) {
+                auto group = mZones.getUnchecked(i)->getZone().roundRobinGroup;
+
+                if (group == 0) {
+                    mEntries.push_back({ static_cast<int>(mZoneIndices.size()), 1 });
+                    mZoneIndices.push_back(i);
+                }
+                else if (std::find(groups.begin(), groups.end(), group) == groups.end()) {
+                    groups.push_back(group);
+                }
+            }
+
+            for (auto group : groups) {
+                Entry entry{ static_cast<int>(mZoneIndices.size()), 0 };
+
+                for (auto i : covering) {
+                    if (mZones.getUnchecked(i)->getZone().roundRobinGroup == group) {
+                        mZoneIndices.push_back(i);
+                        ++entry.numZones;
+                    }
+                }
+
+                mEntries.push_back(entry);
+            }
+
+            cell.numEntries = static_cast<int>(mEntries.size()) - cell.firstEntry;
+            previous = covering;
+        }
+    }
+}
+
+bool SampleKeymap::appliesToNote(int midiNoteNumber) {
+    return mMappedKeys[midiNoteNumber & 127];
+}
+
+bool SampleKeymap::appliesToChannel(int /*midiChannel*/) {
+    return true;
+}
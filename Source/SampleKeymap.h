@@ -0,0 +1,85 @@
+/*
+  ==============================================================================
+
+    SampleKeymap.h
+    Created: 17 Oct 2026 6:02:14pm
+    Author:  tmobr
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "SampleSound.h"
+
+//==============================================================================
+/*
+    A set of zones plus a table, built once, of which zones answer every key
+    and velocity. A note-on costs one lookup and then one step per zone that
+    actually sounds, however many zones the keymap holds.
+
+    Neighbouring cells covered by the same zones share table entries, and with
+    them their round-robin position.
+*/
+class SampleKeymap  : public juce::SynthesiserSound
+{
+public:
+    using Ptr = juce::ReferenceCountedObjectPtr<SampleKeymap>;
+
+    explicit SampleKeymap(const juce::ReferenceCountedArray<SampleSound>& zonesToUse);
+    ~SampleKeymap() override;
+
+    const juce::ReferenceCountedArray<SampleSound>& getZones() const noexcept { return mZones; }
+
+    // Calls playZone with every zone that should sound for this note. Audio
+    // thread only, since it moves round-robin groups on to their next zone.
+    template <typename Callback>
+    void forEachZone(int midiNoteNumber, float velocity, Callback&& playZone) noexcept
+    {
+        const auto& cell = mCells[static_cast<size_t>(getCellIndex(midiNoteNumber, velocity))];
+
+        for (int i = cell.firstEntry; i < cell.firstEntry + cell.numEntries; ++i) {
+            auto& entry = mEntries[static_cast<size_t>(i)];
+            auto index = entry.firstZone;
+
+            if (entry.numZones > 1) {
+                index += static_cast<int>(entry.nextTurn++ % static_cast<juce::uint32>(entry.numZones));
+            }
+
+            playZone(mZones.getUnchecked(mZoneIndices[static_cast<size_t>(index)]));
+        }
+    }
+
+    bool appliesToNote(int midiNoteNumber) override;
+    bool appliesToChannel(int midiChannel) override;
+
+private:
+    struct Cell
+    {
+        int firstEntry = 0, numEntries = 0;
+    };
+
+    // One zone that always plays, or a round-robin group taking turns.
+    struct Entry
+    {
+        int firstZone = 0, numZones = 0;
+        juce::uint32 nextTurn = 0;
+    };
+
+    static int getCellIndex(int midiNoteNumber, float velocity) noexcept
+    {
+        return (midiNoteNumber & 127) * 128 + juce::jlimit(1, 127, juce::roundToInt(velocity * 127.0f));
+    }
+
+    void buildTable();
+
+    juce::ReferenceCountedArray<SampleSound> mZones;
+
+    std::vector<Cell> mCells;
+    std::vector<Entry> mEntries;
+    std::vector<int> mZoneIndices;
+    juce::BigInteger mMappedKeys;
+
+    JUCE_LEAK_DETECTOR (SampleKeymap)
+};
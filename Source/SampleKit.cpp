@@ -0,0 +1,310 @@
+/*
+  ==============================================================================
+
+    SampleKit.cpp
+    Created: 17 Oct 2026 11:04:52pm
+    Author:  tmobr
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "SampleKit.h"
+
+//==============================================================================
+SampleKit::SampleKit(const juce::File& file)
+{
+    auto mapping = std::make_shared<const juce::MemoryMappedFile>(file, juce::MemoryMappedFile::readOnly);
+    const auto* base = static_cast<const char*>(mapping->getData());
+    const auto size = static_cast<juce::int64>(mapping->getSize());
+
+    if (base == nullptr || size < pageSize) {
+        return;
+    }
+
+    juce::MemoryInputStream header(base, static_cast<size_t>(pageSize), false);
+
+    if (header.readInt() != magic || header.readInt() != version) {
+        return;
+    }
+
+    const auto indexOffset = header.readInt64();
+    const auto indexSize = header.readInt64();
+
+    if (indexOffset < pageSize || indexSize <= 0 || indexOffset + indexSize > size) {
+        return;
+    }
+
+    mIndex = juce::ValueTree::readFromData(base + indexOffset, static_cast<size_t>(indexSize));
+
+    if (!mIndex.hasType("KIT")) {
+        return;
+    }
+
+    mSamples = mIndex.getChildWithName("SAMPLES");
+
+    // Every sample has to lie inside the file, or a voice would read past the
+    // end of the mapping.
+    for (const auto& sample : mSamples) {
+        const auto offset = static_cast<juce::int64>(sample.getProperty("OFFSET"));
+        const auto length = static_cast<juce::int64>(sample.getProperty("LENGTH"));
+        const auto numChannels = static_cast<int>(sample.getProperty("CHANNELS"));
+        const auto encoding = static_cast<int>(sample.getProperty("ENCODING"));
+
+        if (offset < pageSize || length <= 0 || length > std::numeric_limits<int>::max()
+            || numChannels < 1 || numChannels > 2 || encoding < 0 || encoding > static_cast<int>(SampleData::Encoding::int24)) {
+            return;
+        }
+
+        const auto bytesPerSample = static_cast<juce::int64>(SampleData::getBytesPerSample(static_cast<SampleData::Encoding>(encoding)));
+        const auto peaksOffset = static_cast<juce::int64>(sample.getProperty("PEAKS_OFFSET"));
+        const auto peaksSize = static_cast<juce::int64>(sample.getProperty("PEAKS_SIZE"));
+
+        if (offset + length * numChannels * bytesPerSample > indexOffset
+            || peaksOffset < pageSize || peaksSize < 0 || peaksOffset + peaksSize > indexOffset) {
+            return;
+        }
+
+        // Voices divide by the sample rate and play from START up to END.
+        const auto sampleRate = static_cast<double>(sample.getProperty("SAMPLE_RATE"));
+        const auto start = static_cast<juce::int64>(sample.getProperty("START", 0));
+        const auto end = static_cast<juce::int64>(sample.getProperty("END", length));
+
+        if (!(sampleRate > 0.0) || start < 0 || end > length || start >= end) {
+            return;
+        }
+    }
+
+    for (const auto& zoneState : mIndex.getChildWithName("ZONES")) {
+        const auto sample = static_cast<int>(zoneState.getProperty("SAMPLE", -1));
+
+        if (zoneState.hasType("ZONE") && juce::isPositiveAndBelow(sample, mSamples.getNumChildren())) {
+            mZones.push_back({ SampleZone::fromValueTree(zoneState), sample });
+        }
+    }
+
+    mMapping = std::move(mapping);
+}
+
+juce::ValueTree SampleKit::getParameters() const {
+    return mIndex.getChildWithName("SETTINGS").getChild(0);
+}
+
+SampleData::Ptr SampleKit::createSample(int index) const {
+    jassert(isValid());
+
+    const auto state = mSamples.getChild(index);
+    const auto path = state.getProperty("SOURCE").toString();
+
+    SampleData::Ptr data = new SampleData(juce::File::isAbsolutePath(path) ? juce::File(path) : juce::File(),
+                                          state.getProperty("HASH").toString(),
+                                          state.getProperty("SAMPLE_RATE"),
+                                          state.getProperty("LENGTH"),
+                                          state.getProperty("CHANNELS"),
+                                          static_cast<SampleData::Encoding>(static_cast<int>(state.getProperty("ENCODING"))),
+                                          mMapping,
+                                          static_cast<size_t>(static_cast<juce::int64>(state.getProperty("OFFSET"))));
+
+    const auto* peaks = static_cast<const char*>(mMapping->getData()) + static_cast<juce::int64>(state.getProperty("PEAKS_OFFSET"));
+    juce::MemoryInputStream stream(peaks, static_cast<size_t>(static_cast<juce::int64>(state.getProperty("PEAKS_SIZE"))), false);
+
+    if (!data->getPeaks().readFrom(stream) || data->getPeaks().getNumSamples() != data->getLengthInSamples()) {
+        return nullptr;
+    }
+
+    data->setTrim(state.getProperty("START", 0), state.getProperty("END", state.getProperty("LENGTH")));
+
+    return data;
+}
+
+bool SampleKit::isKitFile(const juce::File& file) {
+    return file.hasFileExtension(fileExtension);
+}
+
+//==============================================================================
+// Samples used by several zones are written once. Everything goes to a
+// temporary file first, so a failed export never leaves half a kit behind.
+bool SampleKit::write(const juce::File& destination, const SampleKeymap& keymap,
+                      const juce::ValueTree& parameters, juce::AudioFormatManager& formatManager,
+                      const std::function<bool (double)>& onProgress) {
+    juce::Array<const SampleData*> toWrite;
+    juce::int64 totalFrames = 0, framesWritten = 0;
+
+    for (auto* zone : keymap.getZones()) {
+        if (toWrite.addIfNotAlreadyThere(&zone->getSampleData())) {
+            totalFrames += zone->getSampleData().getLengthInSamples();
+        }
+    }
+
+    const auto onFramesWritten = [&] (int numFrames) {
+        framesWritten += numFrames;
+        return onProgress == nullptr || onProgress(static_cast<double>(framesWritten) / static_cast<double>(juce::jmax(static_cast<juce::int64>(1), totalFrames)));
+    };
+
+    juce::TemporaryFile temp(destination);
+    auto output = std::make_unique<juce::FileOutputStream>(temp.getFile());
+    auto& stream = *output;
+
+    if (stream.failedToOpen()) {
+        return false;
+    }
+
+    writeHeader(stream, 0, 0);
+
+    juce::ValueTree samplesState("SAMPLES");
+    juce::ValueTree zonesState("ZONES");
+    juce::Array<const SampleData*> written;
+
+    for (auto* zone : keymap.getZones()) {
+        const auto& data = zone->getSampleData();
+        auto index = written.indexOf(&data);
+
+        if (index < 0) {
+            auto sampleState = writeSample(stream, data, formatManager, onFramesWritten);
+
+            if (!sampleState.isValid()) {
+                return false;
+            }
+
+            index = written.size();
+            written.add(&data);
+            samplesState.appendChild(sampleState, nullptr);
+        }
+
+        auto zoneState = zone->getZone().toValueTree();
+        zoneState.setProperty("SAMPLE", index, nullptr);
+        zonesState.appendChild(zoneState, nullptr);
+    }
+
+    juce::ValueTree settings("SETTINGS");
+    settings.appendChild(parameters.createCopy(), nullptr);
+
+    juce::ValueTree index("KIT");
+    index.setProperty("VERSION", version, nullptr);
+    index.appendChild(settings, nullptr);
+    index.appendChild(samplesState, nullptr);
+    index.appendChild(zonesState, nullptr);
+
+    const auto indexOffset = stream.getPosition();
+    index.writeToStream(stream);
+    const auto indexSize = stream.getPosition() - indexOffset;
+
+    stream.setPosition(0);
+    writeHeader(stream, indexOffset, indexSize);
+    stream.flush();
+
+    if (stream.getStatus().failed()) {
+        return false;
+    }
+
+    // Closed first, since some systems won't move a file that's still open.
+    output.reset();
+    return temp.overwriteTargetFileWithTemporary();
+}
+
+// Frames come from wherever the sample already holds them: its preloaded
+// audio, its mapping, or, for streamed samples, the file itself.
+juce::ValueTree SampleKit::writeSample(juce::FileOutputStream& stream, const SampleData& data, juce::AudioFormatManager& formatManager,
+                                       const std::function<bool (int)>& onFramesWritten) {
+    const auto length = data.getLengthInSamples();
+    const auto numChannels = data.getNumChannels();
+
+    // Kit samples are preloaded in full, so they're indexed with ints.
+    if (length <= 0 || length > std::numeric_limits<int>::max() || numChannels < 1) {
+        return {};
+    }
+
+    std::unique_ptr<juce::AudioFormatReader> reader;
+
+    if (data.isStreaming()) {
+        reader.reset(formatManager.createReaderFor(data.getAudioFile()));
+
+        if (reader == nullptr) {
+            return {};
+        }
+    }
+
+    const auto encoding = data.getEncoding();
+    const auto bytesPerSample = SampleData::getBytesPerSample(encoding);
+    const auto channelSize = length * static_cast<juce::int64>(bytesPerSample);
+
+    padToPage(stream);
+    const auto offset = stream.getPosition();
+
+    juce::AudioBuffer<float> chunk(2, writeChunkSize);
+    juce::HeapBlock<juce::uint8> encoded(static_cast<size_t>(writeChunkSize) * bytesPerSample);
+    PeakPyramid peaks;
+    peaks.reset(length);
+
+    for (juce::int64 start = 0; start < length; start += writeChunkSize) {
+        const auto numFrames = static_cast<int>(juce::jmin(static_cast<juce::int64>(writeChunkSize), length - start));
+        auto* left = chunk.getWritePointer(0);
+        auto* right = chunk.getWritePointer(1);
+
+        if (reader != nullptr) {
+            float* const channels[] = { left, right };
+            reader->read(channels, numChannels, start, numFrames);
+        }
+        else if (data.isMemoryMapped()) {
+            data.readMapped(start, numFrames, left, right);
+        }
+        else {
+            data.readPreloaded(static_cast<int>(start), numFrames, left, right);
+        }
+
+        peaks.addSamples(chunk.getArrayOfReadPointers(), numChannels, numFrames);
+
+        // Channels are stored one after another, so each chunk lands in as
+        // many places as there are channels.
+        for (int channel = 0; channel < numChannels; ++channel) {
+            SampleData::encodeSamples(chunk.getReadPointer(channel), encoded.get(), numFrames, encoding);
+
+            stream.setPosition(offset + channel * channelSize + start * static_cast<juce::int64>(bytesPerSample));
+            stream.write(encoded.get(), static_cast<size_t>(numFrames) * bytesPerSample);
+        }
+
+        if (!onFramesWritten(numFrames)) {
+            return {};
+        }
+    }
+
+    peaks.finish();
+    stream.setPosition(offset + numChannels * channelSize);
+
+    // The peaks follow the frames rather than sitting in the index, so
+    // opening a kit never copies them.
+    const auto peaksOffset = stream.getPosition();
+    peaks.writeTo(stream);
+
+    juce::ValueTree state("SAMPLE");
+    state.setProperty("SOURCE", data.getFile().getFullPathName(), nullptr);
+    state.setProperty("HASH", data.getContentHash(), nullptr);
+    state.setProperty("SAMPLE_RATE", data.getSourceSampleRate(), nullptr);
+    state.setProperty("LENGTH", static_cast<int>(length), nullptr);
+    state.setProperty("CHANNELS", numChannels, nullptr);
+    state.setProperty("ENCODING", static_cast<int>(encoding), nullptr);
+    state.setProperty("OFFSET", offset, nullptr);
+    state.setProperty("START", data.getStartFrame(), nullptr);
+    state.setProperty("END", data.getEndFrame(), nullptr);
+    state.setProperty("PEAKS_OFFSET", peaksOffset, nullptr);
+    state.setProperty("PEAKS_SIZE", stream.getPosition() - peaksOffset, nullptr);
+
+    return state;
+}
+
+void SampleKit::writeHeader(juce::OutputStream& stream, juce::int64 indexOffset, juce::int64 indexSize) {
+    stream.writeInt(magic);
+    stream.writeInt(version);
+    stream.writeInt64(indexOffset);
+    stream.writeInt64(indexSize);
+
+    padToPage(stream);
+}
+
+void SampleKit::padToPage(juce::OutputStream& stream) {
+    const auto remainder = stream.getPosition() % pageSize;
+
+    if (remainder != 0) {
+        stream.writeRepeatedByte(0, static_cast<size_t>(pageSize - remainder));
+    }
+}
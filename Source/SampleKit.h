@@ -0,0 +1,82 @@
+/*
+  ==============================================================================
+
+    SampleKit.h
+    Created: 17 Oct 2026 11:04:52pm
+    Author:  tmobr
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "SampleKeymap.h"
+
+//==============================================================================
+/*
+    A kit file: the zones of a keymap, the parameters they were set up with,
+    and every sample's peaks and audio, laid out to be memory-mapped.
+
+    A header page says where the index is. Each sample's frames follow, one
+    channel after another, starting on a page boundary and in the encoding
+    the sample was held in when exported, and then its peaks. The index, a
+    binary ValueTree, comes last. Opening a kit only maps it and reads the
+    index. The loader reads in each sample's head, and the rest of the audio
+    pages come in as voices first touch them. Every instance playing the same
+    kit shares them through the OS page cache.
+*/
+class SampleKit
+{
+public:
+    struct Zone
+    {
+        SampleZone zone;
+        int sample = 0;
+    };
+
+    explicit SampleKit(const juce::File& file);
+
+    bool isValid() const noexcept { return mMapping != nullptr; }
+
+    // The parameter state saved with the kit, or an invalid tree.
+    juce::ValueTree getParameters() const;
+
+    int getNumSamples() const noexcept { return mSamples.getNumChildren(); }
+    const std::vector<Zone>& getZones() const noexcept { return mZones; }
+
+    // Cheap: the frames stay in the mapping and the peaks are stored ready to
+    // use. Returns nullptr if the stored peaks are damaged.
+    SampleData::Ptr createSample(int index) const;
+
+    static bool isKitFile(const juce::File& file);
+
+    // Reads every sample of the keymap in full, so this blocks for as long as
+    // the audio takes to copy. Never call it from the audio thread. After each
+    // chunk, onProgress gets the fraction written so far and can abandon the
+    // export by returning false.
+    static bool write(const juce::File& destination, const SampleKeymap& keymap,
+                      const juce::ValueTree& parameters, juce::AudioFormatManager& formatManager,
+                      const std::function<bool (double)>& onProgress = nullptr);
+
+    static constexpr const char* fileExtension = ".sskit";
+
+private:
+    static juce::ValueTree writeSample(juce::FileOutputStream& stream, const SampleData& data, juce::AudioFormatManager& formatManager,
+                                       const std::function<bool (int)>& onFramesWritten);
+    static void writeHeader(juce::OutputStream& stream, juce::int64 indexOffset, juce::int64 indexSize);
+    static void padToPage(juce::OutputStream& stream);
+
+    static constexpr int magic = 0x544b5353;   // "SSKT"
+    static constexpr int version = 1;
+
+    // Large enough for the 16 KB pages of some ARM systems as well as 4 KB ones.
+    static constexpr int pageSize = 1 << 14;
+    static constexpr int writeChunkSize = 1 << 16;
+
+    std::shared_ptr<const juce::MemoryMappedFile> mMapping;
+    juce::ValueTree mIndex, mSamples;
+    std::vector<Zone> mZones;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SampleKit)
+};
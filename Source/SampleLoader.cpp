@@ -0,0 +1,372 @@
+/*
+  ==============================================================================
+
+    SampleLoader.cpp
+    Created: 17 Oct 2026 9:12:05am
+    Author:  tmobr
+
+  ==============================================================================
+*/
+
+#include "SampleLoader.h"
+
+//==============================================================================
+SampleLoader::SampleLoader(juce::AudioFormatManager& formatManager, Callback onSampleLoaded)
+    : juce::Thread("Sample Loader"), mFormatManager(formatManager), mOnSampleLoaded(std::move(onSampleLoaded))
+{
+}
+
+SampleLoader::~SampleLoader()
+{
+    stopThread(4000);
+}
+
+void SampleLoader::loadAsync(const juce::File& file) {
+    SampleZone zone;
+    zone.file = file;
+
+    loadAsync(std::vector<SampleZone>{ zone });
+}
+
+void SampleLoader::loadAsync(const std::vector<SampleZone>& zones) {
+    {
+        const juce::ScopedLock sl(mRequestLock);
+        mRequestedZones = zones;
+        mHasRequest = true;
+        mCancelled = false;
+        mLoading = true;
+    }
+
+    notify();
+}
+
+double SampleLoader::getProgress() const {
+    const auto numToLoad = mNumFilesToLoad.load();
+    return numToLoad > 0 ? static_cast<double>(mNumFilesLoaded) / numToLoad : 0.0;
+}
+
+void SampleLoader::cancel() {
+    mCancelled = true;
+}
+
+void SampleLoader::run() {
+    while (!threadShouldExit()) {
+        std::vector<SampleZone> zones;
+        bool hasRequest = false;
+
+        {
+            const juce::ScopedLock sl(mRequestLock);
+            std::swap(zones, mRequestedZones);
+            std::swap(hasRequest, mHasRequest);
+        }
+
+        if (hasRequest) {
+            if (auto sample = buildKeymap(zones)) {
+                mSamples.add(sample);
+                mOnSampleLoaded(sample);
+            }
+
+            const juce::ScopedLock sl(mRequestLock);
+            mLoading = mHasRequest;
+        }
+
+        releaseUnusedSamples();
+        wait(500);
+    }
+}
+
+LoadedSample::Ptr SampleLoader::buildKeymap(const std::vector<SampleZone>& zones) {
+    // A kit brings its own zones and audio, so it stands in for the request.
+    if (zones.size() == 1 && SampleKit::isKitFile(zones.front().file)) {
+        return loadKit(zones.front().file);
+    }
+
+    juce::Array<juce::File> files;
+
+    for (const auto& zone : zones) {
+        files.addIfNotAlreadyThere(zone.file);
+    }
+
+    std::vector<SampleData::Ptr> loaded(static_cast<size_t>(files.size()));
+    loadFiles(files, zones.empty() ? juce::File() : zones.back().file, loaded);
+
+    if (shouldStop()) {
+        return nullptr;
+    }
+
+    juce::ReferenceCountedArray<SampleSound> sounds;
+    SampleData::Ptr shown;
+
+    for (const auto& zone : zones) {
+        if (auto data = loaded[static_cast<size_t>(files.indexOf(zone.file))]) {
+            // Still played, since the file at the saved path is the best guess
+            // there is, but the session no longer sounds as it did.
+            if (zone.contentHash.isNotEmpty() && zone.contentHash != data->getContentHash()) {
+                DBG("Sample changed since the session was saved: " << zone.file.getFullPathName());
+            }
+
+            auto loadedZone = zone;
+            loadedZone.contentHash = data->getContentHash();
+
+            sounds.add(new SampleSound(data, loadedZone));
+            shown = data;
+        }
+    }
+
+    if (sounds.isEmpty()) {
+        return nullptr;
+    }
+
+    LoadedSample::Ptr sample = new LoadedSample();
+    sample->keymap = new SampleKeymap(sounds);
+    sample->shown = shown;
+
+    return sample;
+}
+
+// Nothing is decoded here: every sample plays from the kit's mapping, and
+// the pool shares them with anything else already using the same audio. Only
+// each sample's head is read, to bring it into memory before anything plays.
+LoadedSample::Ptr SampleLoader::loadKit(const juce::File& file) {
+    SampleKit kit(file);
+
+    if (!kit.isValid() || kit.getZones().empty()) {
+        DBG("Not a usable kit: " << file.getFullPathName());
+        return nullptr;
+    }
+
+    mNumFilesLoaded = 0;
+    mNumFilesToLoad = kit.getNumSamples();
+
+    const auto headLength = mLazyLoadingEnabled ? numLazyPreloadSamples : numPreloadSamples;
+    std::vector<SampleData::Ptr> samples;
+
+    for (int i = 0; i < kit.getNumSamples(); ++i) {
+        // Faulting in every head of a large kit takes a while.
+        if (shouldStop()) {
+            return nullptr;
+        }
+
+        auto data = kit.createSample(i);
+
+        if (data == nullptr) {
+            DBG("Damaged kit: " << file.getFullPathName());
+            return nullptr;
+        }
+
+        data = mPool->add(data);
+        data->touchKitPages(headLength);
+
+        samples.push_back(data);
+        ++mNumFilesLoaded;
+    }
+
+    if (shouldStop()) {
+        return nullptr;
+    }
+
+    juce::ReferenceCountedArray<SampleSound> sounds;
+
+    for (const auto& kitZone : kit.getZones()) {
+        const auto& data = samples[static_cast<size_t>(kitZone.sample)];
+
+        auto zone = kitZone.zone;
+        zone.contentHash = data->getContentHash();
+
+        sounds.add(new SampleSound(data, zone));
+    }
+
+    LoadedSample::Ptr sample = new LoadedSample();
+    sample->keymap = new SampleKeymap(sounds);
+    sample->shown = samples[static_cast<size_t>(kit.getZones().back().sample)];
+    sample->kitParameters = kit.getParameters().createCopy();
+
+    return sample;
+}
+
+// A kit takes about as long as its largest file, rather than all of them in turn.
+void SampleLoader::loadFiles(const juce::Array<juce::File>& files, const juce::File& shownFile, std::vector<SampleData::Ptr>& loaded) {
+    const bool lazy = mLazyLoadingEnabled;
+
+    mNumFilesLoaded = 0;
+    mNumFilesToLoad = files.size();
+
+    for (int i = 0; i < files.size(); ++i) {
+        const auto needsPeaks = !lazy || files.getReference(i) == shownFile;
+
+        mDecodePool->addJob([this, &files, &loaded, i, needsPeaks] {
+            if (!shouldStop()) {
+                loaded[static_cast<size_t>(i)] = getSampleData(files.getReference(i), needsPeaks);
+            }
+
+            ++mNumFilesLoaded;
+        });
+    }
+
+    // The jobs write into this caller's locals, so every one of them has to
+    // finish, even after a cancel. Cancelled ones return almost at once. The
+    // pool is shared with other instances, so only count our own jobs.
+    while (mNumFilesLoaded < files.size()) {
+        wait(20);
+    }
+}
+
+// A pooled sample is reused as it is, so one first loaded lazily keeps an
+// empty thumbnail until nothing uses it any more.
+SampleData::Ptr SampleLoader::getSampleData(const juce::File& file, bool needsPeaks) {
+    // Hashed once here and passed on, since it means reading both ends of the file.
+    const auto contentHash = SampleData::computeContentHash(file);
+
+    if (auto data = mPool->find(file, contentHash)) {
+        return data;
+    }
+
+    auto data = decode(file, contentHash, needsPeaks);
+
+    if (data != nullptr) {
+        data = mPool->add(data);
+    }
+
+    return data;
+}
+
+SampleData::Ptr SampleLoader::decode(const juce::File& file, const juce::String& contentHash, bool needsPeaks) {
+    const bool lazy = mLazyLoadingEnabled;
+
+    std::unique_ptr<juce::AudioFormatReader> reader(mFormatManager.createReaderFor(file));
+
+    if (reader == nullptr) {
+        return nullptr;
+    }
+
+    const auto decodedFile = getDecodedFile(file, contentHash, *reader, lazy);
+
+    if (decodedFile != juce::File()) {
+        if (auto* decodedReader = mFormatManager.createReaderFor(decodedFile)) {
+            reader.reset(decodedReader);
+        }
+    }
+
+    const auto& audioFile = decodedFile != juce::File() ? decodedFile : file;
+    auto mapped = mMemoryMappingEnabled ? createMappedReader(audioFile) : nullptr;
+
+    const auto streamingThreshold = static_cast<juce::int64>(streamingThresholdSeconds * reader->sampleRate);
+    const auto headLength = lazy ? numLazyPreloadSamples : numPreloadSamples;
+    const auto preloadHeadOnly = mapped != nullptr
+                              || reader->lengthInSamples > std::numeric_limits<int>::max()
+                              || (lazy && reader->lengthInSamples > headLength)
+                              || (mStreamingEnabled && reader->lengthInSamples > juce::jmax(streamingThreshold, numPreloadSamples));
+
+    SampleData::Ptr data = new SampleData(file, contentHash, *reader, preloadHeadOnly ? headLength : reader->lengthInSamples, std::move(mapped), decodedFile);
+    auto& peaks = data->getPeaks();
+
+    // In-memory samples are already fully decoded, so only streamed and
+    // mapped ones need another pass over the file.
+    if (needsPeaks && preloadHeadOnly) {
+        buildPeaks(*reader, peaks);
+    }
+    else if (needsPeaks) {
+        const float* channels[] = { data->getPreloadedChannel(0), data->getPreloadedChannel(1) };
+
+        peaks.reset(data->getNumPreloadedSamples());
+        peaks.addSamples(channels, data->getNumChannels(), data->getNumPreloadedSamples());
+        peaks.finish();
+    }
+
+    if (mOnsetTrimmingEnabled) {
+        data->trimSilence();
+    }
+
+    // Integer sources convert back exactly, so holding them at their own
+    // width costs nothing in quality. Floats, and anything decoded through
+    // the cache, stay as they are.
+    if (mCompactEncodingEnabled && !reader->usesFloatingPointData) {
+        if (reader->bitsPerSample <= 16) {
+            data->encode(SampleData::Encoding::int16);
+        }
+        else if (reader->bitsPerSample <= 24) {
+            data->encode(SampleData::Encoding::int24);
+        }
+    }
+
+    if (shouldStop()) {
+        return nullptr;
+    }
+
+    return data;
+}
+
+std::unique_ptr<juce::MemoryMappedAudioFormatReader> SampleLoader::createMappedReader(const juce::File& file) {
+    auto* format = mFormatManager.findFormatForFileExtension(file.getFileExtension());
+
+    if (format == nullptr) {
+        return nullptr;
+    }
+
+    // Formats that can't be mapped, such as compressed ones, return nothing here.
+    std::unique_ptr<juce::MemoryMappedAudioFormatReader> mapped(format->createMemoryMappedReader(file));
+
+    if (mapped == nullptr || !mapped->mapEntireFile()) {
+        return nullptr;
+    }
+
+    return mapped;
+}
+
+juce::File SampleLoader::getDecodedFile(const juce::File& file, const juce::String& contentHash, juce::AudioFormatReader& reader, bool onlyIfCached) {
+    auto* format = mFormatManager.findFormatForFileExtension(file.getFileExtension());
+
+    if (!mDecodedCacheEnabled || format == nullptr || !format->isCompressed()) {
+        return {};
+    }
+
+    // Filling the cache means decoding the whole file, which is just what
+    // lazy loading puts off.
+    if (onlyIfCached) {
+        return mCache.findDecodedFile(file, contentHash);
+    }
+
+    return mCache.getDecodedFile(file, contentHash, reader, mPool->getAudioFiles());
+}
+
+void SampleLoader::buildPeaks(juce::AudioFormatReader& reader, PeakPyramid& peaks) {
+    juce::AudioBuffer<float> chunk(juce::jmin(2, static_cast<int>(reader.numChannels)), peakChunkSize);
+
+    peaks.reset(reader.lengthInSamples);
+
+    for (juce::int64 start = 0; start < reader.lengthInSamples && !shouldStop(); start += peakChunkSize) {
+        auto numToRead = static_cast<int>(juce::jmin(static_cast<juce::int64>(peakChunkSize), reader.lengthInSamples - start));
+
+        reader.read(&chunk, 0, numToRead, start, true, true);
+        peaks.addSamples(chunk.getArrayOfReadPointers(), chunk.getNumChannels(), numToRead);
+    }
+
+    peaks.finish();
+}
+
+void SampleLoader::releaseUnusedSamples() {
+    // A count of one means only this array still refers to the sample, a
+    // keymap count of one means the synthesiser has let go of it, and zone
+    // counts of one mean no voice or stream is still playing them.
+    auto isUnused = [] (const LoadedSample& sample) {
+        if (sample.getReferenceCount() != 1 || sample.keymap->getReferenceCount() != 1) {
+            return false;
+        }
+
+        for (auto* zone : sample.keymap->getZones()) {
+            if (zone->getReferenceCount() != 1) {
+                return false;
+            }
+        }
+
+        return true;
+    };
+
+    for (int i = mSamples.size(); --i >= 0;) {
+        if (isUnused(*mSamples.getUnchecked(i))) {
+            mSamples.remove(i);
+        }
+    }
+
+    mPool->releaseUnused();
+}
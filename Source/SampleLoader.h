@@ -0,0 +1,158 @@
+/*
+  ==============================================================================
+
+    SampleLoader.h
+    Created: 17 Oct 2026 9:12:05am
+    Author:  tmobr
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "SampleKeymap.h"
+#include "SamplePool.h"
+#include "DecodedCache.h"
+#include "SampleKit.h"
+
+//==============================================================================
+/*
+    A keymap ready to play, together with the sample the thumbnail shows.
+    Instances are immutable once published, so the GUI and the audio thread
+    can both read them without locking.
+*/
+class LoadedSample  : public juce::ReferenceCountedObject
+{
+public:
+    using Ptr = juce::ReferenceCountedObjectPtr<LoadedSample>;
+
+    SampleKeymap::Ptr keymap;
+    SampleData::Ptr shown;
+    juce::ValueTree kitParameters;  // the parameters saved in a kit, if this is one
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LoadedSample)
+};
+
+//==============================================================================
+/*
+    The threads that decode files for every loader in the process, shared
+    through a juce::SharedResourcePointer so that several plugin instances
+    don't each start one per core.
+*/
+class DecodeThreadPool  : public juce::ThreadPool
+{
+public:
+    DecodeThreadPool() : juce::ThreadPool(juce::jmax(1, juce::SystemStats::getNumCpus() - 1)) {}
+};
+
+//==============================================================================
+/*
+    Builds keymaps on a background thread, decoding the files of a keymap in
+    parallel, each at most once, into the process-wide pool, and keeps
+    everything it has handed out alive until nothing else references it.
+    Keymaps, zones and sample data are only ever deleted from a loader thread,
+    never from the audio thread.
+*/
+class SampleLoader  : public juce::Thread
+{
+public:
+    using Callback = std::function<void (LoadedSample::Ptr)>;
+
+    SampleLoader(juce::AudioFormatManager& formatManager, Callback onSampleLoaded);
+    ~SampleLoader() override;
+
+    // Only the most recent request is honoured if several arrive while busy.
+    // A single file is mapped across the whole keyboard with its root at C3,
+    // and a kit file brings its own zones.
+    void loadAsync(const juce::File& file);
+    void loadAsync(const std::vector<SampleZone>& zones);
+
+    // Progress through the files of the current request, for the editor.
+    bool isLoading() const { return mLoading; }
+    double getProgress() const;
+
+    // Abandons the current request, keeping whatever was loaded before it.
+    void cancel();
+
+    // Samples longer than the threshold keep only a head in memory and stream
+    // the rest. Anything too long to index with an int always streams.
+    void setStreamingEnabled(bool shouldStream) { mStreamingEnabled = shouldStream; }
+    bool isStreamingEnabled() const { return mStreamingEnabled; }
+
+    // Uncompressed files are played from a memory mapping instead of being
+    // decoded into memory or streamed. Anything that can't be mapped falls
+    // back to the usual path.
+    void setMemoryMappingEnabled(bool shouldMap) { mMemoryMappingEnabled = shouldMap; }
+    bool isMemoryMappingEnabled() const { return mMemoryMappingEnabled; }
+
+    // Compressed files are decoded once into an on-disk cache and read from
+    // there afterwards, instead of being decoded on every load.
+    void setDecodedCacheEnabled(bool shouldCache) { mDecodedCacheEnabled = shouldCache; }
+    bool isDecodedCacheEnabled() const { return mDecodedCacheEnabled; }
+    void setDecodedCacheSize(juce::int64 maxBytes) { mCache.setMaxSize(maxBytes); }
+
+    // Loads only a short head of every sample, leaving the rest to be read
+    // from disk when a zone first plays, and skips the peak pass for all but
+    // the sample the thumbnail shows. Large kits open almost at once, and
+    // what's resident follows what actually plays: streamed audio only while
+    // voices use it, mapped audio as the OS pages it in and out. Compressed
+    // files use the decoded cache only when it already holds them.
+    void setLazyLoadingEnabled(bool shouldLoadLazily) { mLazyLoadingEnabled = shouldLoadLazily; }
+    bool isLazyLoadingEnabled() const { return mLazyLoadingEnabled; }
+
+    // Samples start at their onset instead of at their first frame, and stop
+    // where their tail fades below the same threshold.
+    void setOnsetTrimmingEnabled(bool shouldTrim) { mOnsetTrimmingEnabled = shouldTrim; }
+    bool isOnsetTrimmingEnabled() const { return mOnsetTrimmingEnabled; }
+
+    // Preloaded audio from 16- and 24-bit files is kept at that width instead
+    // of as floats.
+    void setCompactEncodingEnabled(bool shouldEncode) { mCompactEncodingEnabled = shouldEncode; }
+    bool isCompactEncodingEnabled() const { return mCompactEncodingEnabled; }
+
+    void run() override;
+
+private:
+    LoadedSample::Ptr buildKeymap(const std::vector<SampleZone>& zones);
+    LoadedSample::Ptr loadKit(const juce::File& file);
+    void loadFiles(const juce::Array<juce::File>& files, const juce::File& shownFile, std::vector<SampleData::Ptr>& loaded);
+    bool shouldStop() const { return threadShouldExit() || mCancelled; }
+    SampleData::Ptr getSampleData(const juce::File& file, bool needsPeaks);
+    SampleData::Ptr decode(const juce::File& file, const juce::String& contentHash, bool needsPeaks);
+    std::unique_ptr<juce::MemoryMappedAudioFormatReader> createMappedReader(const juce::File& file);
+    juce::File getDecodedFile(const juce::File& file, const juce::String& contentHash, juce::AudioFormatReader& reader, bool onlyIfCached);
+    void buildPeaks(juce::AudioFormatReader& reader, PeakPyramid& peaks);
+    void releaseUnusedSamples();
+
+    static constexpr double streamingThresholdSeconds = 30.0;
+    static constexpr juce::int64 numPreloadSamples = 1 << 16;
+    static constexpr juce::int64 numLazyPreloadSamples = 1 << 14;
+    static constexpr int peakChunkSize = 1 << 16;
+
+    juce::AudioFormatManager& mFormatManager;
+    Callback mOnSampleLoaded;
+
+    juce::CriticalSection mRequestLock;
+    std::vector<SampleZone> mRequestedZones;
+    bool mHasRequest = false;
+
+    std::atomic<bool> mLoading { false };
+    std::atomic<bool> mCancelled { false };
+    std::atomic<int> mNumFilesToLoad { 0 };
+    std::atomic<int> mNumFilesLoaded { 0 };
+
+    std::atomic<bool> mStreamingEnabled { true };
+    std::atomic<bool> mMemoryMappingEnabled { true };
+    std::atomic<bool> mDecodedCacheEnabled { true };
+    std::atomic<bool> mCompactEncodingEnabled { true };
+    std::atomic<bool> mLazyLoadingEnabled { false };
+    std::atomic<bool> mOnsetTrimmingEnabled { true };
+
+    juce::SharedResourcePointer<SamplePool> mPool;
+    DecodedCache mCache;
+    juce::ReferenceCountedArray<LoadedSample> mSamples;
+    juce::SharedResourcePointer<DecodeThreadPool> mDecodePool;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SampleLoader)
+};
@@ -0,0 +1,70 @@
+/*
+  ==============================================================================
+
+    SamplePool.cpp
+    Created: 17 Oct 2026 6:21:45pm
+    Author:  tmobr
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "SamplePool.h"
+
+//==============================================================================
+SamplePool::SamplePool()
+{
+}
+
+SampleData::Ptr SamplePool::find(const juce::File& file, const juce::String& contentHash) const {
+    const juce::ScopedLock sl(mLock);
+
+    for (auto* sample : mSamples) {
+        if (sample->getFile() == file && sample->getContentHash() == contentHash) {
+            return sample;
+        }
+    }
+
+    return nullptr;
+}
+
+SampleData::Ptr SamplePool::add(SampleData::Ptr sample) {
+    const juce::ScopedLock sl(mLock);
+
+    // Two instances can miss on the same file and decode it side by side;
+    // only the first copy is kept.
+    for (auto* existing : mSamples) {
+        if (existing->getFile() == sample->getFile() && existing->getContentHash() == sample->getContentHash()) {
+            return existing;
+        }
+    }
+
+    mSamples.add(sample);
+    return sample;
+}
+
+void SamplePool::releaseUnused() {
+    const juce::ScopedLock sl(mLock);
+
+    for (int i = mSamples.size(); --i >= 0;) {
+        if (mSamples.getUnchecked(i)->getReferenceCount() == 1) {
+            mSamples.remove(i);
+        }
+    }
+}
+
+int SamplePool::size() const {
+    const juce::ScopedLock sl(mLock);
+    return mSamples.size();
+}
+
+juce::Array<juce::File> SamplePool::getAudioFiles() const {
+    const juce::ScopedLock sl(mLock);
+    juce::Array<juce::File> files;
+
+    for (auto* sample : mSamples) {
+        files.addIfNotAlreadyThere(sample->getAudioFile());
+    }
+
+    return files;
+}
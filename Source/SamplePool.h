@@ -0,0 +1,52 @@
+/*
+  ==============================================================================
+
+    SamplePool.h
+    Created: 17 Oct 2026 6:21:45pm
+    Author:  tmobr
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "SampleData.h"
+
+//==============================================================================
+/*
+    Decoded samples keyed by file and content hash, so a file used by several
+    zones, keymaps or plugin instances is only decoded and held once. Loaders
+    share one pool per process through a juce::SharedResourcePointer, and
+    whichever instance loads a file first decides how it's held.
+
+    A file edited on disk gets a new hash, so it's decoded again rather than
+    served stale.
+*/
+class SamplePool
+{
+public:
+    SamplePool();
+
+    SampleData::Ptr find(const juce::File& file, const juce::String& contentHash) const;
+
+    // Returns the pooled sample, which is an earlier one for the same file if
+    // another loader added it first.
+    SampleData::Ptr add(SampleData::Ptr sample);
+
+    // Drops samples that nothing outside the pool refers to any more. This is
+    // where sample data gets deleted, so never call it from the audio thread.
+    void releaseUnused();
+
+    int size() const;
+
+    // The files pooled samples play from. For compressed sources these are
+    // decoded cache entries, which streaming voices may reopen at any time.
+    juce::Array<juce::File> getAudioFiles() const;
+
+private:
+    mutable juce::CriticalSection mLock;
+    juce::ReferenceCountedArray<SampleData> mSamples;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SamplePool)
+};
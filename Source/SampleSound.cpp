@@ -0,0 +1,66 @@
+/*
+  ==============================================================================
+
+    SampleSound.cpp
+    Created: 17 Oct 2026 10:41:27am
+    Author:  tmobr
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "SampleSound.h"
+
+//==============================================================================
+juce::ValueTree SampleZone::toValueTree() const {
+    juce::ValueTree state("ZONE");
+
+    state.setProperty("FILE", file.getFullPathName(), nullptr);
+    state.setProperty("HASH", contentHash, nullptr);
+    state.setProperty("LOW_KEY", lowKey, nullptr);
+    state.setProperty("HIGH_KEY", highKey, nullptr);
+    state.setProperty("ROOT_NOTE", rootNote, nullptr);
+    state.setProperty("LOW_VELOCITY", lowVelocity, nullptr);
+    state.setProperty("HIGH_VELOCITY", highVelocity, nullptr);
+    state.setProperty("ROUND_ROBIN_GROUP", roundRobinGroup, nullptr);
+
+    return state;
+}
+
+SampleZone SampleZone::fromValueTree(const juce::ValueTree& state) {
+    SampleZone zone;
+    const auto path = state.getProperty("FILE").toString();
+
+    if (juce::File::isAbsolutePath(path)) {
+        zone.file = juce::File(path);
+    }
+
+    zone.contentHash = state.getProperty("HASH").toString();
+    zone.lowKey = state.getProperty("LOW_KEY", zone.lowKey);
+    zone.highKey = state.getProperty("HIGH_KEY", zone.highKey);
+    zone.rootNote = state.getProperty("ROOT_NOTE", zone.rootNote);
+    zone.lowVelocity = state.getProperty("LOW_VELOCITY", zone.lowVelocity);
+    zone.highVelocity = state.getProperty("HIGH_VELOCITY", zone.highVelocity);
+    zone.roundRobinGroup = state.getProperty("ROUND_ROBIN_GROUP", zone.roundRobinGroup);
+
+    return zone;
+}
+
+//==============================================================================
+SampleSound::SampleSound(SampleData::Ptr sampleData, const SampleZone& zoneToUse)
+    : sample(std::move(sampleData)),
+      zone(zoneToUse)
+{
+}
+
+SampleSound::~SampleSound()
+{
+}
+
+bool SampleSound::appliesToNote(int midiNoteNumber) {
+    return midiNoteNumber >= zone.lowKey && midiNoteNumber <= zone.highKey;
+}
+
+bool SampleSound::appliesToChannel(int /*midiChannel*/) {
+    return true;
+}
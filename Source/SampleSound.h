@@ -0,0 +1,72 @@
+/*
+  ==============================================================================
+
+    SampleSound.h
+    Created: 17 Oct 2026 10:41:27am
+    Author:  tmobr
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "SampleData.h"
+
+//==============================================================================
+// Where a file sits in a keymap. Zones that share a non-zero round-robin group
+// and cover the same key and velocity take turns; all others layer.
+struct SampleZone
+{
+    juce::File file;
+    int lowKey = 0, highKey = 127;
+    int rootNote = 60;
+    int lowVelocity = 1, highVelocity = 127;
+    int roundRobinGroup = 0;
+
+    // The file's SampleData::getContentHash(), filled in by the loader and
+    // saved with the session. Empty when not yet known.
+    juce::String contentHash;
+
+    // The zone as sessions and kits store it.
+    juce::ValueTree toValueTree() const;
+    static SampleZone fromValueTree(const juce::ValueTree& state);
+};
+
+//==============================================================================
+/*
+    One zone of a keymap: a key and velocity range playing shared SampleData.
+    This is the sound a voice is started with.
+*/
+class SampleSound  : public juce::SynthesiserSound
+{
+public:
+    using Ptr = juce::ReferenceCountedObjectPtr<SampleSound>;
+
+    SampleSound(SampleData::Ptr sampleData, const SampleZone& zone);
+    ~SampleSound() override;
+
+    const SampleData& getSampleData() const noexcept { return *sample; }
+    const SampleZone& getZone() const noexcept { return zone; }
+
+    const juce::String& getName() const noexcept { return sample->getName(); }
+    const juce::File& getFile() const noexcept { return sample->getFile(); }
+
+    int getNumPreloadedSamples() const noexcept { return sample->getNumPreloadedSamples(); }
+    juce::int64 getLengthInSamples() const noexcept { return sample->getLengthInSamples(); }
+    juce::int64 getStartFrame() const noexcept { return sample->getStartFrame(); }
+    juce::int64 getEndFrame() const noexcept { return sample->getEndFrame(); }
+    bool isStreaming() const noexcept { return sample->isStreaming(); }
+
+    double getSourceSampleRate() const noexcept { return sample->getSourceSampleRate(); }
+    int getMidiRootNote() const noexcept { return zone.rootNote; }
+
+    bool appliesToNote(int midiNoteNumber) override;
+    bool appliesToChannel(int midiChannel) override;
+
+private:
+    SampleData::Ptr sample;
+    SampleZone zone;
+
+    JUCE_LEAK_DETECTOR (SampleSound)
+};
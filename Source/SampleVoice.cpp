@@ -0,0 +1,73 @@
+/*
+  ==============================================================================
+
+    SampleVoice.cpp
+    Created: 17 Oct 2026 11:20:52am
+    Author:  tmobr
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "SampleVoice.h"
+#include "SamplerSynth.h"
+
+//==============================================================================
+SampleVoice::SampleVoice(DiskStreamer& streamer) : mStream(streamer)
+{
+}
+
+SampleVoice::~SampleVoice()
+{
+}
+
+// SamplerSynth only ever holds keymaps, and hands voices the SampleSound
+// zones they pick, so there's no need for RTTI on the audio thread.
+bool SampleVoice::canPlaySound(juce::SynthesiserSound* sound) {
+    jassert(dynamic_cast<const SampleSound*>(sound) != nullptr);
+    return sound != nullptr;
+}
+
+void SampleVoice::startNote(int midiNoteNumber, float velocity, juce::SynthesiserSound* s, int /*pitchWheel*/) {
+    jassert(dynamic_cast<SampleSound*>(s) != nullptr); // this object can only play SampleSounds!
+    auto* sound = static_cast<SampleSound*>(s);
+
+    auto pitchRatio = std::pow(2.0, (midiNoteNumber - sound->getMidiRootNote()) / 12.0)
+                        * sound->getSourceSampleRate() / getSampleRate();
+
+    if (sound->isStreaming()) {
+        mStream.start(*sound, sound->getNumPreloadedSamples());
+    }
+
+    mOwner->getVoiceBank().start(mIndex, *sound, sound->isStreaming() ? &mStream : nullptr, pitchRatio, velocity);
+}
+
+void SampleVoice::stopNote(float /*velocity*/, bool allowTailOff) {
+    if (allowTailOff) {
+        mOwner->getVoiceBank().release(mIndex);
+        mOwner->voiceReleased(mIndex);
+    }
+    else {
+        finish();
+    }
+}
+
+void SampleVoice::finish() {
+    if (auto* sound = static_cast<SampleSound*>(getCurrentlyPlayingSound().get())) {
+        if (sound->isStreaming()) {
+            mStream.stop();
+        }
+    }
+
+    clearCurrentNote();
+
+    mOwner->getVoiceBank().remove(mIndex);
+    mOwner->voiceStopped(mIndex);
+}
+
+void SampleVoice::pitchWheelMoved(int /*newValue*/) {}
+void SampleVoice::controllerMoved(int /*controllerNumber*/, int /*newValue*/) {}
+
+void SampleVoice::renderNextBlock(juce::AudioBuffer<float>&, int /*startSample*/, int /*numSamples*/) {
+    // Rendering happens for all voices at once in SamplerSynth::renderVoices().
+}
@@ -0,0 +1,55 @@
+/*
+  ==============================================================================
+
+    SampleVoice.h
+    Created: 17 Oct 2026 11:20:52am
+    Author:  tmobr
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "SampleSound.h"
+#include "DiskStreamer.h"
+
+class SamplerSynth;
+
+//==============================================================================
+/*
+    A handle onto one slot of the owner's VoiceBank, which does the actual
+    rendering. The voice keeps the Synthesiser's bookkeeping and its own
+    StreamBuffer for sounds that stream from disk.
+*/
+class SampleVoice  : public juce::SynthesiserVoice
+{
+public:
+    explicit SampleVoice(DiskStreamer& streamer);
+    ~SampleVoice() override;
+
+    void setOwner(SamplerSynth* owner, int index) noexcept { mOwner = owner; mIndex = index; }
+    int getIndex() const noexcept { return mIndex; }
+
+    bool canPlaySound(juce::SynthesiserSound*) override;
+
+    void startNote(int midiNoteNumber, float velocity, juce::SynthesiserSound*, int pitchWheel) override;
+    void stopNote(float velocity, bool allowTailOff) override;
+
+    void pitchWheelMoved(int newValue) override;
+    void controllerMoved(int controllerNumber, int newValue) override;
+
+    void renderNextBlock(juce::AudioBuffer<float>&, int startSample, int numSamples) override;
+    using juce::SynthesiserVoice::renderNextBlock;
+
+    // Called by the owner once the bank reports that this voice has finished.
+    void finish();
+
+private:
+    StreamBuffer mStream;
+
+    SamplerSynth* mOwner = nullptr;
+    int mIndex = -1;
+
+    JUCE_LEAK_DETECTOR (SampleVoice)
+};
@@ -0,0 +1,304 @@
+/*
+  ==============================================================================
+
+    SamplerSynth.cpp
+    Created: 17 Oct 2026 2:34:18pm
+    Author:  tmobr
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "SamplerSynth.h"
+#include "SampleVoice.h"
+#include "SampleKeymap.h"
+
+//==============================================================================
+SamplerSynth::SamplerSynth(DiskStreamer& streamer) : mStreamer(streamer)
+{
+    mHeads.fill(-1);
+    mTails.fill(-1);
+    mNoteHeads.fill(-1);
+
+    sounds.ensureStorageAllocated(1);
+}
+
+SamplerSynth::~SamplerSynth()
+{
+}
+
+void SamplerSynth::setSound(juce::SynthesiserSound* sound) noexcept {
+    const juce::ScopedLock sl(lock);
+
+    // removeSound() would shrink the array and free its storage, and the next
+    // add would allocate it again.
+    if (sounds.isEmpty()) {
+        sounds.add(sound);
+    }
+    else {
+        sounds.set(0, sound);
+    }
+}
+
+void SamplerSynth::setNumVoices(int numVoices) {
+    if (numVoices == getNumVoices()) {
+        return;
+    }
+
+    const juce::ScopedLock sl(lock);
+
+    clearVoices();
+
+    mLinks.assign(static_cast<size_t>(numVoices), {});
+    mHeads.fill(-1);
+    mTails.fill(-1);
+    mNoteHeads.fill(-1);
+    mNumActive = 0;
+
+    mBank.prepare(numVoices);
+
+    for (int i = 0; i < numVoices; ++i) {
+        auto* voice = new SampleVoice(mStreamer);
+        voice->setOwner(this, i);
+        addVoice(voice);
+
+        mLinks[static_cast<size_t>(i)].list = -1;
+        append(i, freeList);
+    }
+
+    setPolyphony(mPolyphony);
+}
+
+void SamplerSynth::setCurrentPlaybackSampleRate(double sampleRate) {
+    juce::Synthesiser::setCurrentPlaybackSampleRate(sampleRate);
+    mBank.setSampleRate(sampleRate);
+}
+
+void SamplerSynth::renderVoices(juce::AudioBuffer<float>& outputAudio, int startSample, int numSamples) {
+    mBank.render(outputAudio, startSample, numSamples);
+
+    for (auto index : mBank.getFinishedVoices()) {
+        getSampleVoice(index)->finish();
+    }
+
+    mBank.clearFinished();
+
+    // Every voice the synth counts as playing holds a slot in the bank. If the
+    // two disagree, a finished voice wasn't reported, and processBlock's idle
+    // fast path would never run again.
+    jassert(mBank.getNumActive() == mNumActive);
+}
+
+//==============================================================================
+void SamplerSynth::noteOn(int midiChannel, int midiNoteNumber, float velocity) {
+    const juce::ScopedLock sl(lock);
+    const auto noteSlot = getNoteSlot(midiChannel, midiNoteNumber);
+
+    for (auto* sound : sounds) {
+        if (sound->appliesToNote(midiNoteNumber) && sound->appliesToChannel(midiChannel)) {
+            // If hitting a note that's still ringing, stop it first (it could be
+            // still playing because of the sustain or sostenuto pedal).
+            for (int i = mNoteHeads[static_cast<size_t>(noteSlot)]; i >= 0;) {
+                auto next = mLinks[static_cast<size_t>(i)].nextOnNote;
+                stopVoice(voices.getUnchecked(i), 1.0f, true);
+                i = next;
+            }
+
+            // Only keymaps are ever added to this synth. Each zone the keymap
+            // picks gets a voice of its own.
+            static_cast<SampleKeymap*>(sound)->forEachZone(midiNoteNumber, velocity, [&] (SampleSound* zone) {
+                if (auto* voice = findFreeVoice(zone, midiChannel, midiNoteNumber, isNoteStealingEnabled())) {
+                    startVoice(voice, zone, midiChannel, midiNoteNumber, velocity);
+                    voiceStarted(static_cast<SampleVoice*>(voice)->getIndex(), midiChannel, midiNoteNumber);
+                }
+            });
+        }
+    }
+}
+
+void SamplerSynth::noteOff(int midiChannel, int midiNoteNumber, float velocity, bool allowTailOff) {
+    const juce::ScopedLock sl(lock);
+
+    for (int i = mNoteHeads[static_cast<size_t>(getNoteSlot(midiChannel, midiNoteNumber))]; i >= 0;) {
+        auto next = mLinks[static_cast<size_t>(i)].nextOnNote;
+        auto* voice = voices.getUnchecked(i);
+
+        if (voice->isKeyDown()) {
+            voice->setKeyDown(false);
+
+            if (!(voice->isSustainPedalDown() || voice->isSostenutoPedalDown())) {
+                stopVoice(voice, velocity, allowTailOff);
+            }
+        }
+
+        i = next;
+    }
+}
+
+juce::SynthesiserVoice* SamplerSynth::findFreeVoice(juce::SynthesiserSound* sound, int midiChannel, int midiNoteNumber, bool stealIfNoneAvailable) const {
+    if (mNumActive < mPolyphony && mHeads[freeList] >= 0) {
+        return voices.getUnchecked(mHeads[freeList]);
+    }
+
+    return stealIfNoneAvailable ? findVoiceToSteal(sound, midiChannel, midiNoteNumber) : nullptr;
+}
+
+juce::SynthesiserVoice* SamplerSynth::findVoiceToSteal(juce::SynthesiserSound*, int midiChannel, int midiNoteNumber) const {
+    if (mStealMode == StealMode::sameNote) {
+        auto sameNote = mNoteHeads[static_cast<size_t>(getNoteSlot(midiChannel, midiNoteNumber))];
+
+        if (sameNote >= 0) {
+            return voices.getUnchecked(sameNote);
+        }
+    }
+
+    if (mStealMode == StealMode::quietest) {
+        // Only runs when every voice is busy, and looks at released voices
+        // first since they're fading out anyway.
+        for (auto list : { releasedList, heldList }) {
+            int quietest = -1;
+            float quietestLevel = std::numeric_limits<float>::max();
+
+            for (int i = mHeads[static_cast<size_t>(list)]; i >= 0; i = mLinks[static_cast<size_t>(i)].next) {
+                auto level = mBank.getCurrentLevel(i);
+
+                if (level < quietestLevel) {
+                    quietest = i;
+                    quietestLevel = level;
+                }
+            }
+
+            if (quietest >= 0) {
+                return voices.getUnchecked(quietest);
+            }
+        }
+    }
+
+    // Lists are kept in start order, so the oldest voice is always at the head.
+    if (mHeads[releasedList] >= 0) {
+        return voices.getUnchecked(mHeads[releasedList]);
+    }
+
+    return mHeads[heldList] >= 0 ? voices.getUnchecked(mHeads[heldList]) : nullptr;
+}
+
+//==============================================================================
+void SamplerSynth::voiceStarted(int index, int midiChannel, int midiNoteNumber) noexcept {
+    if (mLinks[static_cast<size_t>(index)].list == freeList) {
+        ++mNumActive;
+    }
+
+    unlink(index);
+    removeFromNote(index);
+
+    append(index, heldList);
+    addToNote(index, getNoteSlot(midiChannel, midiNoteNumber));
+}
+
+void SamplerSynth::voiceReleased(int index) noexcept {
+    if (mLinks[static_cast<size_t>(index)].list != heldList) {
+        return;
+    }
+
+    unlink(index);
+    append(index, releasedList);
+}
+
+void SamplerSynth::voiceStopped(int index) noexcept {
+    if (mLinks[static_cast<size_t>(index)].list == freeList) {
+        return;
+    }
+
+    --mNumActive;
+
+    unlink(index);
+    removeFromNote(index);
+    append(index, freeList);
+}
+
+//==============================================================================
+void SamplerSynth::unlink(int index) noexcept {
+    auto& links = mLinks[static_cast<size_t>(index)];
+
+    if (links.list < 0) {
+        return;
+    }
+
+    auto list = static_cast<size_t>(links.list);
+
+    if (links.prev >= 0) {
+        mLinks[static_cast<size_t>(links.prev)].next = links.next;
+    }
+    else {
+        mHeads[list] = links.next;
+    }
+
+    if (links.next >= 0) {
+        mLinks[static_cast<size_t>(links.next)].prev = links.prev;
+    }
+    else {
+        mTails[list] = links.prev;
+    }
+
+    links.prev = links.next = -1;
+    links.list = -1;
+}
+
+void SamplerSynth::append(int index, int list) noexcept {
+    auto& links = mLinks[static_cast<size_t>(index)];
+    auto listIndex = static_cast<size_t>(list);
+
+    links.list = list;
+    links.prev = mTails[listIndex];
+    links.next = -1;
+
+    if (mTails[listIndex] >= 0) {
+        mLinks[static_cast<size_t>(mTails[listIndex])].next = index;
+    }
+    else {
+        mHeads[listIndex] = index;
+    }
+
+    mTails[listIndex] = index;
+}
+
+void SamplerSynth::addToNote(int index, int noteSlot) noexcept {
+    auto& links = mLinks[static_cast<size_t>(index)];
+    auto& head = mNoteHeads[static_cast<size_t>(noteSlot)];
+
+    links.noteSlot = noteSlot;
+    links.prevOnNote = -1;
+    links.nextOnNote = head;
+
+    if (head >= 0) {
+        mLinks[static_cast<size_t>(head)].prevOnNote = index;
+    }
+
+    head = index;
+}
+
+void SamplerSynth::removeFromNote(int index) noexcept {
+    auto& links = mLinks[static_cast<size_t>(index)];
+
+    if (links.noteSlot < 0) {
+        return;
+    }
+
+    if (links.prevOnNote >= 0) {
+        mLinks[static_cast<size_t>(links.prevOnNote)].nextOnNote = links.nextOnNote;
+    }
+    else {
+        mNoteHeads[static_cast<size_t>(links.noteSlot)] = links.nextOnNote;
+    }
+
+    if (links.nextOnNote >= 0) {
+        mLinks[static_cast<size_t>(links.nextOnNote)].prevOnNote = links.prevOnNote;
+    }
+
+    links.prevOnNote = links.nextOnNote = -1;
+    links.noteSlot = -1;
+}
+
+SampleVoice* SamplerSynth::getSampleVoice(int index) const noexcept {
+    return static_cast<SampleVoice*>(voices.getUnchecked(index));
+}
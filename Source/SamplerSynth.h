@@ -0,0 +1,108 @@
+/*
+  ==============================================================================
+
+    SamplerSynth.h
+    Created: 17 Oct 2026 2:34:18pm
+    Author:  tmobr
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "DiskStreamer.h"
+#include "VoiceBank.h"
+
+class SampleVoice;
+
+//==============================================================================
+/*
+    A Synthesiser that allocates voices in constant time. Every voice is on
+    exactly one of three intrusive lists (free, held, released), and voices
+    sounding a note are also chained per channel and note, so note-on, note-off
+    and stealing never scan the whole voice array.
+
+    Its sounds are SampleKeymaps. Voices are started with the keymap's zones,
+    one voice per zone that answers the note and velocity.
+
+    The voices themselves don't render; their playback state lives in a
+    VoiceBank that renders all of them together.
+*/
+class SamplerSynth  : public juce::Synthesiser
+{
+public:
+    enum class StealMode
+    {
+        oldest,
+        quietest,
+        sameNote
+    };
+
+    explicit SamplerSynth(DiskStreamer& streamer);
+    ~SamplerSynth() override;
+
+    // Allocates voices, so only call this while the audio thread is stopped.
+    void setNumVoices(int numVoices);
+
+    // Makes this the only sound, replacing the current one in its slot. The
+    // slot is allocated up front, so this never allocates or frees storage
+    // and is safe on the audio thread.
+    void setSound(juce::SynthesiserSound* sound) noexcept;
+
+    void setPolyphony(int maxActiveVoices) noexcept { mPolyphony = juce::jlimit(1, juce::jmax(1, static_cast<int>(mLinks.size())), maxActiveVoices); }
+    void setStealMode(StealMode mode) noexcept { mStealMode = mode; }
+
+    int getNumActiveVoices() const noexcept { return mNumActive; }
+    VoiceBank& getVoiceBank() noexcept { return mBank; }
+
+    void setCurrentPlaybackSampleRate(double sampleRate) override;
+
+    void noteOn(int midiChannel, int midiNoteNumber, float velocity) override;
+    void noteOff(int midiChannel, int midiNoteNumber, float velocity, bool allowTailOff) override;
+
+    // Called by SampleVoice as it changes state.
+    void voiceReleased(int index) noexcept;
+    void voiceStopped(int index) noexcept;
+
+protected:
+    juce::SynthesiserVoice* findFreeVoice(juce::SynthesiserSound*, int midiChannel, int midiNoteNumber, bool stealIfNoneAvailable) const override;
+    juce::SynthesiserVoice* findVoiceToSteal(juce::SynthesiserSound*, int midiChannel, int midiNoteNumber) const override;
+
+    void renderVoices(juce::AudioBuffer<float>& outputAudio, int startSample, int numSamples) override;
+    using juce::Synthesiser::renderVoices;
+
+private:
+    enum ListId { freeList = 0, heldList, releasedList, numLists };
+
+    struct VoiceLinks
+    {
+        int prev = -1, next = -1;
+        int prevOnNote = -1, nextOnNote = -1;
+        int list = freeList;
+        int noteSlot = -1;
+    };
+
+    static int getNoteSlot(int midiChannel, int midiNoteNumber) noexcept { return (juce::jlimit(1, 16, midiChannel) - 1) * 128 + (midiNoteNumber & 127); }
+
+    void voiceStarted(int index, int midiChannel, int midiNoteNumber) noexcept;
+
+    void unlink(int index) noexcept;
+    void append(int index, int list) noexcept;
+    void addToNote(int index, int noteSlot) noexcept;
+    void removeFromNote(int index) noexcept;
+    SampleVoice* getSampleVoice(int index) const noexcept;
+
+    DiskStreamer& mStreamer;
+    VoiceBank mBank;
+
+    std::vector<VoiceLinks> mLinks;
+    std::array<int, numLists> mHeads, mTails;
+    std::array<int, 16 * 128> mNoteHeads;
+
+    int mNumActive = 0;
+    int mPolyphony = 1;
+    StealMode mStealMode = StealMode::oldest;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SamplerSynth)
+};
@@ -0,0 +1,665 @@
+/*
+  ==============================================================================
+
+    VoiceBank.cpp
+    Created: 17 Oct 2026 4:20:36pm
+    Author:  tmobr
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "VoiceBank.h"
+#include "Float4.h"
+
+//==============================================================================
+// Each interpolator reads numBefore frames before and numAfter frames after
+// the integer part of every lane's position.
+namespace
+{
+    struct LinearInterpolator
+    {
+        static constexpr int numBefore = 0, numAfter = 1;
+
+        static void process(const float* const* windowL, const float* const* windowR, const int* index, Float4 alpha, const int*,
+                            Float4& left, Float4& right) noexcept
+        {
+            const auto l0 = Float4::set(windowL[0][index[0]], windowL[1][index[1]], windowL[2][index[2]], windowL[3][index[3]]);
+            const auto l1 = Float4::set(windowL[0][index[0] + 1], windowL[1][index[1] + 1], windowL[2][index[2] + 1], windowL[3][index[3] + 1]);
+            const auto r0 = Float4::set(windowR[0][index[0]], windowR[1][index[1]], windowR[2][index[2]], windowR[3][index[3]]);
+            const auto r1 = Float4::set(windowR[0][index[0] + 1], windowR[1][index[1] + 1], windowR[2][index[2] + 1], windowR[3][index[3] + 1]);
+
+            left = l0 + (l1 - l0) * alpha;
+            right = r0 + (r1 - r0) * alpha;
+        }
+    };
+
+    // Four-point Catmull-Rom Hermite.
+    struct CubicInterpolator
+    {
+        static constexpr int numBefore = 1, numAfter = 2;
+
+        static Float4 gather(const float* const* window, const int* index, int offset) noexcept
+        {
+            return Float4::set(window[0][index[0] + offset], window[1][index[1] + offset], window[2][index[2] + offset], window[3][index[3] + offset]);
+        }
+
+        static Float4 interpolate(const float* const* window, const int* index, Float4 alpha) noexcept
+        {
+            const auto ym1 = gather(window, index, -1);
+            const auto y0 = gather(window, index, 0);
+            const auto y1 = gather(window, index, 1);
+            const auto y2 = gather(window, index, 2);
+
+            const auto half = Float4::broadcast(0.5f);
+            const auto c1 = (y1 - ym1) * half;
+            const auto c2 = ym1 - y0 * Float4::broadcast(2.5f) + y1 * Float4::broadcast(2.0f) - y2 * half;
+            const auto c3 = (y2 - ym1) * half + (y0 - y1) * Float4::broadcast(1.5f);
+
+            return ((c3 * alpha + c2) * alpha + c1) * alpha + y0;
+        }
+
+        static void process(const float* const* windowL, const float* const* windowR, const int* index, Float4 alpha, const int*,
+                            Float4& left, Float4& right) noexcept
+        {
+            left = interpolate(windowL, index, alpha);
+            right = interpolate(windowR, index, alpha);
+        }
+    };
+
+    // Polyphase windowed sinc. Taps are vectorised four at a time within each
+    // lane, with coefficients interpolated between neighbouring phases.
+    template <int numTaps>
+    struct SincInterpolator
+    {
+        static_assert (numTaps % 4 == 0, "Taps are processed four at a time");
+
+        static constexpr int numBefore = numTaps / 2 - 1, numAfter = numTaps / 2;
+
+        static void process(const float* const* windowL, const float* const* windowR, const int* index, Float4 alpha, const int* bands,
+                            Float4& left, Float4& right) noexcept
+        {
+            const auto& tables = Resampling::getSincTables<numTaps>();
+
+            float fractions[4], lefts[4], rights[4];
+            alpha.store(fractions);
+
+            for (int lane = 0; lane < 4; ++lane) {
+                const auto phase = fractions[lane] * static_cast<float>(Resampling::numPhases);
+                const auto row = juce::jmin(static_cast<int>(phase), Resampling::numPhases - 1);
+                const auto mix = Float4::broadcast(phase - static_cast<float>(row));
+
+                const auto& table = tables.bands[bands[lane]];
+                const auto* row0 = table.coefficients[row];
+                const auto* row1 = table.coefficients[row + 1];
+                const auto* sourceL = windowL[lane] + index[lane] - numBefore;
+                const auto* sourceR = windowR[lane] + index[lane] - numBefore;
+
+                auto sumL = Float4::broadcast(0.0f);
+                auto sumR = Float4::broadcast(0.0f);
+
+                for (int tap = 0; tap < numTaps; tap += 4) {
+                    const auto c0 = Float4::load(row0 + tap);
+                    const auto c = c0 + (Float4::load(row1 + tap) - c0) * mix;
+
+                    sumL = sumL + Float4::load(sourceL + tap) * c;
+                    sumR = sumR + Float4::load(sourceR + tap) * c;
+                }
+
+                lefts[lane] = sumL.sum();
+                rights[lane] = sumR.sum();
+            }
+
+            left = Float4::load(lefts);
+            right = Float4::load(rights);
+        }
+    };
+
+    // The furthest back any interpolator reaches, which streams keep in their
+    // ring so the next block's first taps are still there.
+    constexpr int maxNumBefore = SincInterpolator<32>::numBefore;
+}
+
+//==============================================================================
+VoiceBank::VoiceBank()
+{
+    Resampling::getSincTables<8>();
+    Resampling::getSincTables<32>();
+}
+
+VoiceBank::~VoiceBank()
+{
+}
+
+void VoiceBank::prepare(int maxVoices) {
+    const auto numSlots = static_cast<size_t>((maxVoices + numLanes - 1) / numLanes * numLanes);
+
+    voiceOfSlot.assign(numSlots, -1);
+    sounds.assign(numSlots, nullptr);
+    streams.assign(numSlots, nullptr);
+    positions.assign(numSlots, 0.0);
+    increments.assign(numSlots, 0.0);
+    stages.assign(numSlots, idleStage);
+
+    for (auto* v : { &levels, &deltas, &lows, &highs, &releaseLevels, &gainsL, &gainsR }) {
+        v->assign(numSlots, 0.0f);
+    }
+
+    slotOfVoice.assign(static_cast<size_t>(maxVoices), -1);
+
+    finished.clear();
+    finished.reserve(static_cast<size_t>(maxVoices));
+
+    silence.assign(silencePadding * 2, 0.0f);
+
+    // Partition 0 renders straight into the output, so only the others need scratch.
+    partitions.resize(maxPartitions);
+
+    for (size_t p = 0; p < partitions.size(); ++p) {
+        auto& partition = partitions[p];
+
+        partition.windows.setSize(numLanes * 2, windowSize);
+        partition.output.setSize(2, p > 0 ? maxChunkSize : 0);
+        partition.finished.clear();
+        partition.finished.reserve(static_cast<size_t>(maxVoices));
+    }
+
+    chunkRates.resize(maxChunkSize / subBlockSize + 1);
+
+    numActive = 0;
+}
+
+void VoiceBank::setSampleRate(double newRate) noexcept {
+    sampleRate = newRate;
+    applyEnvelope();
+}
+
+void VoiceBank::setEnvelopeParameters(const juce::ADSR::Parameters& target, int rampLength) noexcept {
+    // Called every block, so unchanged settings mustn't cost anything.
+    if (target.attack == envelopeTarget.attack && target.decay == envelopeTarget.decay
+         && target.sustain == envelopeTarget.sustain && target.release == envelopeTarget.release) {
+        return;
+    }
+
+    envelopeTarget = target;
+
+    if (rampLength <= 0 || numActive == 0) {
+        envelope = target;
+        rampRemaining = 0;
+        applyEnvelope();
+        return;
+    }
+
+    const auto scale = 1.0f / static_cast<float>(rampLength);
+
+    envelopeStep.attack = (target.attack - envelope.attack) * scale;
+    envelopeStep.decay = (target.decay - envelope.decay) * scale;
+    envelopeStep.sustain = (target.sustain - envelope.sustain) * scale;
+    envelopeStep.release = (target.release - envelope.release) * scale;
+    rampRemaining = rampLength;
+}
+
+//==============================================================================
+void VoiceBank::start(int voiceIndex, const SampleSound& sound, StreamBuffer* stream, double pitchRatio, float velocity) noexcept {
+    auto slot = slotOfVoice[static_cast<size_t>(voiceIndex)];
+
+    if (slot < 0) {
+        jassert(numActive < static_cast<int>(voiceOfSlot.size()));
+        slot = numActive++;
+    }
+
+    const auto i = static_cast<size_t>(slot);
+
+    voiceOfSlot[i] = voiceIndex;
+    slotOfVoice[static_cast<size_t>(voiceIndex)] = slot;
+
+    sounds[i] = &sound;
+    streams[i] = stream;
+    positions[i] = static_cast<double>(sound.getStartFrame());
+    increments[i] = juce::jmin(pitchRatio, maxPitchRatio);
+
+    gainsL[i] = velocity;
+    gainsR[i] = velocity;
+    levels[i] = 0.0f;
+
+    setStage(slot, attackStage, currentRates);
+}
+
+void VoiceBank::release(int voiceIndex) noexcept {
+    auto slot = slotOfVoice[static_cast<size_t>(voiceIndex)];
+
+    if (slot >= 0 && stages[static_cast<size_t>(slot)] < releaseStage) {
+        releaseLevels[static_cast<size_t>(slot)] = levels[static_cast<size_t>(slot)];
+        setStage(slot, releaseStage, currentRates);
+    }
+}
+
+void VoiceBank::remove(int voiceIndex) noexcept {
+    auto slot = slotOfVoice[static_cast<size_t>(voiceIndex)];
+
+    if (slot < 0) {
+        return;
+    }
+
+    const auto to = static_cast<size_t>(slot);
+    const auto last = static_cast<size_t>(numActive - 1);
+
+    auto moveLastInto = [to, last] (auto& v) { v[to] = v[last]; };
+
+    if (to != last) {
+        moveLastInto(voiceOfSlot);
+        moveLastInto(sounds);
+        moveLastInto(streams);
+        moveLastInto(positions);
+        moveLastInto(increments);
+        moveLastInto(stages);
+
+        for (auto* v : { &levels, &deltas, &lows, &highs, &releaseLevels, &gainsL, &gainsR }) {
+            moveLastInto(*v);
+        }
+
+        slotOfVoice[static_cast<size_t>(voiceOfSlot[to])] = slot;
+    }
+
+    // Vacated slots must render as silence when they share a group with live ones.
+    voiceOfSlot[last] = -1;
+    sounds[last] = nullptr;
+    streams[last] = nullptr;
+    increments[last] = 0.0;
+    stages[last] = idleStage;
+    levels[last] = deltas[last] = lows[last] = highs[last] = 0.0f;
+    gainsL[last] = gainsR[last] = 0.0f;
+
+    slotOfVoice[static_cast<size_t>(voiceIndex)] = -1;
+    --numActive;
+}
+
+float VoiceBank::getCurrentLevel(int voiceIndex) const noexcept {
+    auto slot = slotOfVoice[static_cast<size_t>(voiceIndex)];
+    return slot >= 0 ? levels[static_cast<size_t>(slot)] * gainsL[static_cast<size_t>(slot)] : 0.0f;
+}
+
+//==============================================================================
+void VoiceBank::setStage(int slot, int stage, const EnvelopeRates& rates) noexcept {
+    const auto i = static_cast<size_t>(slot);
+    auto& level = levels[i];
+    float target = 0.0f;
+
+    switch (stage) {
+        case attackStage:
+            if (rates.attackRate <= 0.0f) {
+                level = 1.0f;
+                setStage(slot, decayStage, rates);
+                return;
+            }
+
+            deltas[i] = rates.attackRate;
+            target = 1.0f;
+            break;
+
+        case decayStage:
+            if (rates.decayRate <= 0.0f || level <= rates.sustainLevel) {
+                setStage(slot, sustainStage, rates);
+                return;
+            }
+
+            deltas[i] = -rates.decayRate;
+            target = rates.sustainLevel;
+            break;
+
+        case sustainStage:
+            if (rates.sustainLevel <= silenceLevel) {
+                setStage(slot, idleStage, rates);
+                return;
+            }
+
+            level = rates.sustainLevel;
+            deltas[i] = 0.0f;
+            target = level;
+            break;
+
+        case releaseStage:
+            if (rates.releaseSamples <= 0.0 || level <= silenceLevel) {
+                setStage(slot, idleStage, rates);
+                return;
+            }
+
+            // Measured from the level at note-off, so re-deriving it while the
+            // release time is being automated doesn't stretch the tail.
+            deltas[i] = static_cast<float>(-releaseLevels[i] / rates.releaseSamples);
+            target = 0.0f;
+            break;
+
+        default:
+            level = 0.0f;
+            deltas[i] = 0.0f;
+            increments[i] = 0.0;
+            break;
+    }
+
+    stages[i] = stage;
+    lows[i] = juce::jmin(level, target);
+    highs[i] = juce::jmax(level, target);
+}
+
+void VoiceBank::advanceStages(int slot, const EnvelopeRates& rates) noexcept {
+    const auto i = static_cast<size_t>(slot);
+    const auto level = levels[i];
+
+    switch (stages[i]) {
+        case attackStage:  if (level >= 1.0f)                 setStage(slot, decayStage, rates);   break;
+        case decayStage:   if (level <= rates.sustainLevel)   setStage(slot, sustainStage, rates); break;
+        case releaseStage: if (level <= silenceLevel)         setStage(slot, idleStage, rates);    break;
+        default: break;
+    }
+}
+
+// Only moves the shared rates on; render() passes them to the voices.
+void VoiceBank::advanceEnvelope(int numSamples) noexcept {
+    currentRates.changed = false;
+
+    if (rampRemaining <= 0) {
+        return;
+    }
+
+    if (numSamples >= rampRemaining) {
+        envelope = envelopeTarget;
+        rampRemaining = 0;
+    }
+    else {
+        const auto n = static_cast<float>(numSamples);
+
+        envelope.attack += envelopeStep.attack * n;
+        envelope.decay += envelopeStep.decay * n;
+        envelope.sustain += envelopeStep.sustain * n;
+        envelope.release += envelopeStep.release * n;
+        rampRemaining -= numSamples;
+    }
+
+    updateRates();
+    currentRates.changed = true;
+}
+
+void VoiceBank::updateRates() noexcept {
+    auto& rates = currentRates;
+
+    rates.sustainLevel = juce::jlimit(0.0f, 1.0f, envelope.sustain);
+    rates.attackRate = envelope.attack > 0.0f ? static_cast<float>(1.0 / (envelope.attack * sampleRate)) : 0.0f;
+    rates.decayRate = envelope.decay > 0.0f ? static_cast<float>((1.0f - rates.sustainLevel) / (envelope.decay * sampleRate)) : 0.0f;
+    rates.releaseSamples = juce::jmax(0.0f, envelope.release) * sampleRate;
+}
+
+void VoiceBank::applyEnvelope() noexcept {
+    updateRates();
+
+    // Re-entering the current stage picks up the new rates and targets.
+    for (int slot = 0; slot < numActive; ++slot) {
+        if (stages[static_cast<size_t>(slot)] != idleStage) {
+            setStage(slot, stages[static_cast<size_t>(slot)], currentRates);
+        }
+    }
+}
+
+//==============================================================================
+void VoiceBank::render(juce::AudioBuffer<float>& output, int startSample, int numSamples) noexcept {
+    if (numActive == 0) {
+        return;
+    }
+
+    // Voices can also go idle between render calls: started or released with
+    // a zero-length stage, or re-entering a stage when the envelope changes.
+    // The render loop skips idle slots, so they're reported here.
+    for (int slot = 0; slot < numActive; ++slot) {
+        const auto i = static_cast<size_t>(slot);
+
+        if (stages[i] == idleStage) {
+            finished.push_back(voiceOfSlot[i]);
+        }
+        else if (auto* stream = streams[i]) {
+            stream->beginBlock();
+        }
+    }
+
+    auto* outL = output.getWritePointer(0, startSample);
+    auto* outR = output.getNumChannels() > 1 ? output.getWritePointer(1, startSample) : nullptr;
+
+    for (int chunkStart = 0; chunkStart < numSamples; chunkStart += maxChunkSize) {
+        chunkLength = juce::jmin(maxChunkSize, numSamples - chunkStart);
+        chunkL = outL + chunkStart;
+        chunkR = outR != nullptr ? outR + chunkStart : nullptr;
+
+        chunkRates[0] = currentRates;
+        chunkRates[0].changed = false;
+
+        for (int offset = 0, subBlock = 1; offset < chunkLength; offset += subBlockSize, ++subBlock) {
+            advanceEnvelope(juce::jmin(subBlockSize, chunkLength - offset));
+            chunkRates[static_cast<size_t>(subBlock)] = currentRates;
+        }
+
+        numPartitions = planPartitions();
+
+        if (numPartitions > 1) {
+            workers->perform(*this, numPartitions);
+        }
+        else {
+            renderPartition(0);
+        }
+
+        for (int p = 0; p < numPartitions; ++p) {
+            auto& partition = partitions[static_cast<size_t>(p)];
+
+            if (p > 0) {
+                juce::FloatVectorOperations::add(chunkL, partition.output.getReadPointer(0), chunkLength);
+
+                if (chunkR != nullptr) {
+                    juce::FloatVectorOperations::add(chunkR, partition.output.getReadPointer(1), chunkLength);
+                }
+            }
+
+            finished.insert(finished.end(), partition.finished.begin(), partition.finished.end());
+            partition.finished.clear();
+        }
+    }
+
+    for (int slot = 0; slot < numActive; ++slot) {
+        if (auto* stream = streams[static_cast<size_t>(slot)]) {
+            stream->setReadPosition(static_cast<juce::int64>(positions[static_cast<size_t>(slot)]) - maxNumBefore);
+        }
+    }
+}
+
+int VoiceBank::planPartitions() noexcept {
+    const auto numGroups = (numActive + numLanes - 1) / numLanes;
+    auto count = 1;
+
+    // Waking a worker costs more than rendering a group or two.
+    if (workers != nullptr) {
+        count = juce::jlimit(1, juce::jmin(maxPartitions, workers->getNumThreads() + 1), numGroups / minGroupsPerPartition);
+    }
+
+    for (int p = 0; p < count; ++p) {
+        auto& partition = partitions[static_cast<size_t>(p)];
+
+        partition.firstSlot = numGroups * p / count * numLanes;
+        partition.endSlot = juce::jmin(numActive, numGroups * (p + 1) / count * numLanes);
+    }
+
+    return count;
+}
+
+// Runs on the audio thread or a worker. A partition only touches its own
+// slots, streams and scratch, apart from partition 0 adding into the output.
+void VoiceBank::renderPartition(int index) noexcept {
+    auto& partition = partitions[static_cast<size_t>(index)];
+    auto* outL = chunkL;
+    auto* outR = chunkR;
+
+    if (index > 0) {
+        partition.output.clear(0, chunkLength);
+        outL = partition.output.getWritePointer(0);
+        outR = chunkR != nullptr ? partition.output.getWritePointer(1) : nullptr;
+    }
+
+    for (int offset = 0, subBlock = 0; offset < chunkLength; offset += subBlockSize, ++subBlock) {
+        const auto numThisTime = juce::jmin(subBlockSize, chunkLength - offset);
+
+        for (int group = partition.firstSlot; group < partition.endSlot; group += numLanes) {
+            renderGroup(partition, group, outL + offset, outR != nullptr ? outR + offset : nullptr, numThisTime);
+        }
+
+        const auto& rates = chunkRates[static_cast<size_t>(subBlock)];
+        const auto& nextRates = chunkRates[static_cast<size_t>(subBlock + 1)];
+
+        // Stage changes land on sub-block boundaries; in between, each lane's
+        // envelope is clamped at its target so it never overshoots.
+        for (int slot = partition.firstSlot; slot < partition.endSlot; ++slot) {
+            const auto i = static_cast<size_t>(slot);
+
+            if (stages[i] == idleStage) {
+                continue;
+            }
+
+            positions[i] += increments[i] * numThisTime;
+            advanceStages(slot, rates);
+
+            if (positions[i] >= static_cast<double>(sounds[i]->getEndFrame())) {
+                setStage(slot, idleStage, rates);
+            }
+
+            if (stages[i] != idleStage && nextRates.changed) {
+                // Re-entering the current stage picks up the new rates and
+                // targets, and can end the voice if there's nothing left of it.
+                setStage(slot, stages[i], nextRates);
+            }
+
+            if (stages[i] == idleStage) {
+                partition.finished.push_back(voiceOfSlot[i]);
+            }
+        }
+    }
+}
+
+void VoiceBank::renderGroup(Partition& partition, int firstSlot, float* outL, float* outR, int numSamples) noexcept {
+    switch (quality) {
+        case ResamplingQuality::linear: renderGroupWith<LinearInterpolator>(partition, firstSlot, outL, outR, numSamples);  break;
+        case ResamplingQuality::cubic:  renderGroupWith<CubicInterpolator>(partition, firstSlot, outL, outR, numSamples);   break;
+        case ResamplingQuality::sinc8:  renderGroupWith<SincInterpolator<8>>(partition, firstSlot, outL, outR, numSamples);  break;
+        case ResamplingQuality::sinc32: renderGroupWith<SincInterpolator<32>>(partition, firstSlot, outL, outR, numSamples); break;
+    }
+}
+
+template <typename Interpolator>
+void VoiceBank::renderGroupWith(Partition& partition, int firstSlot, float* outL, float* outR, int numSamples) noexcept {
+    const float* windowL[numLanes];
+    const float* windowR[numLanes];
+    float startPositions[numLanes], steps[numLanes];
+    int bands[numLanes];
+
+    for (int lane = 0; lane < numLanes; ++lane) {
+        const auto slot = firstSlot + lane;
+        const auto i = static_cast<size_t>(slot);
+
+        if (slot >= numActive || stages[i] == idleStage) {
+            windowL[lane] = windowR[lane] = silence.data() + silencePadding;
+            startPositions[lane] = steps[lane] = 0.0f;
+            bands[lane] = 0;
+            continue;
+        }
+
+        const auto firstFrame = static_cast<juce::int64>(positions[i]) - Interpolator::numBefore;
+        // One more frame than the interpolator reads, for rounding in the float
+        // positions below.
+        const auto lastFrame = static_cast<juce::int64>(positions[i] + increments[i] * (numSamples - 1)) + Interpolator::numAfter + 1;
+
+        fetchWindows(partition, slot, lane, firstFrame, static_cast<int>(lastFrame - firstFrame + 1), windowL[lane], windowR[lane]);
+
+        startPositions[lane] = static_cast<float>(positions[i] - static_cast<double>(firstFrame));
+        steps[lane] = static_cast<float>(increments[i]);
+        bands[lane] = Resampling::getBand(increments[i]);
+    }
+
+    auto position = Float4::load(startPositions);
+    const auto increment = Float4::load(steps);
+
+    auto level = Float4::load(levels.data() + firstSlot);
+    const auto delta = Float4::load(deltas.data() + firstSlot);
+    const auto low = Float4::load(lows.data() + firstSlot);
+    const auto high = Float4::load(highs.data() + firstSlot);
+    const auto gainL = Float4::load(gainsL.data() + firstSlot);
+    const auto gainR = Float4::load(gainsR.data() + firstSlot);
+
+    int index[numLanes];
+
+    for (int n = 0; n < numSamples; ++n) {
+        const auto alpha = position.split(index);
+
+        Float4 sourceL, sourceR;
+        Interpolator::process(windowL, windowR, index, alpha, bands, sourceL, sourceR);
+
+        level = Float4::min(Float4::max(level + delta, low), high);
+
+        const auto left = sourceL * level * gainL;
+        const auto right = sourceR * level * gainR;
+
+        if (outR != nullptr) {
+            outL[n] += left.sum();
+            outR[n] += right.sum();
+        }
+        else {
+            outL[n] += (left + right).sum() * 0.5f;
+        }
+
+        position = position + increment;
+    }
+
+    level.store(levels.data() + firstSlot);
+}
+
+void VoiceBank::fetchWindows(Partition& partition, int slot, int lane, juce::int64 firstFrame, int numFrames, const float*& left, const float*& right) noexcept {
+    const auto i = static_cast<size_t>(slot);
+    const auto& sound = *sounds[i];
+    const auto& data = sound.getSampleData();
+    const auto numPreloaded = data.getNumPreloadedSamples();
+
+    // The common case reads straight out of preloaded float data without copying.
+    if (firstFrame >= 0 && firstFrame + numFrames <= numPreloaded && data.getEncoding() == SampleData::Encoding::float32) {
+        left = data.getPreloadedChannel(0) + firstFrame;
+        right = data.getPreloadedChannel(1) + firstFrame;
+        return;
+    }
+
+    jassert(numFrames <= windowSize);
+    numFrames = juce::jmin(numFrames, windowSize);
+
+    auto* destL = partition.windows.getWritePointer(lane * 2);
+    auto* destR = partition.windows.getWritePointer(lane * 2 + 1);
+    auto* stream = streams[i];
+    int n = 0;
+
+    // Interpolators reach back before the first frame at the very start.
+    for (; n < numFrames && firstFrame + n < 0; ++n) {
+        destL[n] = destR[n] = 0.0f;
+    }
+
+    if (n < numFrames && firstFrame + n < numPreloaded) {
+        const auto numToCopy = static_cast<int>(juce::jmin(static_cast<juce::int64>(numFrames - n), numPreloaded - (firstFrame + n)));
+
+        data.readPreloaded(static_cast<int>(firstFrame + n), numToCopy, destL + n, destR + n);
+        n += numToCopy;
+    }
+
+    if (n < numFrames && data.isMemoryMapped()) {
+        n += data.readMapped(firstFrame + n, numFrames - n, destL + n, destR + n);
+    }
+
+    for (; n < numFrames; ++n) {
+        const auto frame = firstFrame + n;
+
+        if (frame >= sound.getLengthInSamples() || stream == nullptr || !stream->read(frame, destL[n], destR[n])) {
+            destL[n] = destR[n] = 0.0f;
+        }
+    }
+
+    left = destL;
+    right = destR;
+}
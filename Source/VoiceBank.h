@@ -0,0 +1,158 @@
+/*
+  ==============================================================================
+
+    VoiceBank.h
+    Created: 17 Oct 2026 4:20:36pm
+    Author:  tmobr
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "SampleSound.h"
+#include "DiskStreamer.h"
+#include "RenderWorkers.h"
+#include "Resampling.h"
+
+//==============================================================================
+/*
+    The playback state of every sounding voice, kept as parallel arrays. Active
+    voices are packed into the first slots so they can be rendered four at a
+    time, one voice per SIMD lane. When a voice finishes, the last active slot
+    moves into its place.
+
+    Voice indices are the SamplerSynth's; slots are internal.
+
+    With worker threads attached, large voice counts are split into runs of
+    whole groups, each rendered into its own scratch buffer and summed into
+    the output at the end.
+*/
+class VoiceBank  : private RenderWorkers::Job
+{
+public:
+    static constexpr int numLanes = 4;
+    static constexpr int subBlockSize = 32;
+    static constexpr double maxPitchRatio = 32.0;
+    static constexpr int maxPartitions = 8;
+
+    // Envelopes below this (-100 dB) count as finished, so voices aren't
+    // rendered through inaudible tails.
+    static constexpr float silenceLevel = 1.0e-5f;
+
+    VoiceBank();
+    ~VoiceBank() override;
+
+    // Allocates, so only call this while the audio thread is stopped.
+    void prepare(int maxVoices);
+    void setSampleRate(double newRate) noexcept;
+
+    // Audio thread. Takes effect from the next render call.
+    void setQuality(ResamplingQuality newQuality) noexcept { quality = newQuality; }
+    ResamplingQuality getQuality() const noexcept { return quality; }
+
+    // Set while the audio thread is stopped; nullptr renders on the calling thread only.
+    void setWorkers(RenderWorkers* workersToUse) noexcept { workers = workersToUse; }
+
+    // Every voice shares one envelope. New settings are reached over the next
+    // rampLength samples, a sub-block at a time, so automation doesn't jump at
+    // the host's block boundaries however large they are.
+    void setEnvelopeParameters(const juce::ADSR::Parameters& target, int rampLength) noexcept;
+
+    void start(int voiceIndex, const SampleSound& sound, StreamBuffer* stream, double pitchRatio, float velocity) noexcept;
+    void release(int voiceIndex) noexcept;
+    void remove(int voiceIndex) noexcept;
+
+    int getNumActive() const noexcept { return numActive; }
+    float getCurrentLevel(int voiceIndex) const noexcept;
+
+    // Read-only views of active slots, for reporting playback to the GUI.
+    int getVoiceInSlot(int slot) const noexcept { return voiceOfSlot[static_cast<size_t>(slot)]; }
+    const SampleSound* getSoundInSlot(int slot) const noexcept { return sounds[static_cast<size_t>(slot)]; }
+    double getPositionInSlot(int slot) const noexcept { return positions[static_cast<size_t>(slot)]; }
+    double getIncrementInSlot(int slot) const noexcept { return increments[static_cast<size_t>(slot)]; }
+    float getLevelInSlot(int slot) const noexcept { return levels[static_cast<size_t>(slot)] * gainsL[static_cast<size_t>(slot)]; }
+    double getSampleRate() const noexcept { return sampleRate; }
+
+    // Voices that reached the end of their sample or envelope are collected
+    // here; the owner removes them once the render call has returned.
+    void render(juce::AudioBuffer<float>& output, int startSample, int numSamples) noexcept;
+    const std::vector<int>& getFinishedVoices() const noexcept { return finished; }
+    void clearFinished() noexcept { finished.clear(); }
+
+private:
+    enum Stage { attackStage, decayStage, sustainStage, releaseStage, idleStage };
+
+    struct EnvelopeRates
+    {
+        float attackRate = 0.0f, decayRate = 0.0f, sustainLevel = 1.0f;
+        double releaseSamples = 0.0;
+        bool changed = false;   // differs from the sub-block before
+    };
+
+    // What one thread needs to render a run of slots.
+    struct Partition
+    {
+        juce::AudioBuffer<float> windows, output;
+        std::vector<int> finished;
+        int firstSlot = 0, endSlot = 0;
+    };
+
+    static constexpr int maxChunkSize = 1024;
+    static constexpr int minGroupsPerPartition = 2;
+
+    void setStage(int slot, int stage, const EnvelopeRates& rates) noexcept;
+    void advanceStages(int slot, const EnvelopeRates& rates) noexcept;
+    void advanceEnvelope(int numSamples) noexcept;
+    void updateRates() noexcept;
+    void applyEnvelope() noexcept;
+    int planPartitions() noexcept;
+    void renderPartition(int partition) noexcept override;
+    void renderGroup(Partition& partition, int firstSlot, float* outL, float* outR, int numSamples) noexcept;
+    template <typename Interpolator>
+    void renderGroupWith(Partition& partition, int firstSlot, float* outL, float* outR, int numSamples) noexcept;
+    void fetchWindows(Partition& partition, int slot, int lane, juce::int64 firstFrame, int numFrames, const float*& left, const float*& right) noexcept;
+
+    double sampleRate = 44100.0;
+    int numActive = 0;
+
+    juce::ADSR::Parameters envelope, envelopeTarget, envelopeStep;
+    int rampRemaining = 0;
+
+    EnvelopeRates currentRates;
+
+    // Indexed by slot.
+    std::vector<int> voiceOfSlot;
+    std::vector<const SampleSound*> sounds;
+    std::vector<StreamBuffer*> streams;
+    std::vector<double> positions, increments;
+    std::vector<int> stages;
+    std::vector<float> levels, deltas, lows, highs, releaseLevels;
+    std::vector<float> gainsL, gainsR;
+
+    // Indexed by voice.
+    std::vector<int> slotOfVoice;
+
+    std::vector<int> finished;
+
+    static constexpr int windowSize = 2048;
+
+    // Idle lanes read from the middle of this, so every tap lands on a zero.
+    static constexpr int silencePadding = 32;
+    std::vector<float> silence;
+
+    ResamplingQuality quality = ResamplingQuality::cubic;
+
+    RenderWorkers* workers = nullptr;
+    std::vector<Partition> partitions;
+
+    // The chunk being rendered: the rates in force at each sub-block boundary,
+    // worked out up front so every partition ramps the envelope alike.
+    std::vector<EnvelopeRates> chunkRates;
+    float* chunkL = nullptr;
+    float* chunkR = nullptr;
+    int chunkLength = 0, numPartitions = 1;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (VoiceBank)
+};
@@ -1,102 +1,162 @@
-/*
-  ==============================================================================
-
-    WaveThumbnail.cpp
-    Created: 9 Jul 2024 4:00:44pm
-    Author:  tmobr
-
-  ==============================================================================
-*/
-
-#include <JuceHeader.h>
-#include "WaveThumbnail.h"
-
-//==============================================================================
-WaveThumbnail::WaveThumbnail(SimpleSamplerAudioProcessor& p) : audioProcessor(p)
-{
-    // In your constructor, you should add any child components, and
-    // initialise any special settings that your component needs.
-
-}
-
-WaveThumbnail::~WaveThumbnail()
-{
-}
-
-void WaveThumbnail::paint (juce::Graphics& g)
-{
-    g.fillAll(juce::Colours::cadetblue.darker());
-    auto waveform = audioProcessor.getWaveForm();
-
-    if (waveform.getNumSamples() > 0) {
-        juce::Path p;
-        audioPoints.clear();
-
-        auto ratio = waveform.getNumSamples() / getWidth();
-        auto buffer = waveform.getReadPointer(0);
-
-        for (int sample = 0; sample < waveform.getNumSamples(); sample += ratio) {
-            audioPoints.push_back(buffer[sample]);
-        }
-
-        g.setColour(juce::Colours::yellow);
-        p.startNewSubPath(0, getHeight() / 2);
-
-        for (int sample = 0; sample < audioPoints.size(); ++sample) {
-            auto point = juce::jmap<float>(audioPoints[sample], -1.0f, +1.0f, getHeight(), 0);
-            p.lineTo(sample, point);
-        }
-
-        g.strokePath(p, juce::PathStrokeType(2));
-
-        g.setColour(juce::Colours::white);
-        g.setFont(15.0f);
-        auto bounds = getLocalBounds().reduced(10, 10);
-        g.drawFittedText(fileName, bounds, juce::Justification::topRight, 1);
-
-        int numSamples = audioProcessor.getWaveForm().getNumSamples();
-
-        if (numSamples > 0) {
-            auto playerHeadPosition = juce::jmap<int>(audioProcessor.getSampleCount(), 0, numSamples, 0, getWidth());
-            g.setColour(juce::Colours::white);
-            g.drawLine(playerHeadPosition, 0, playerHeadPosition, getHeight(), 2.0f);
-
-            g.setColour(juce::Colours::black.withAlpha(0.2f));
-            g.fillRect(0, 0, playerHeadPosition, getHeight());
-        }
-    }
-    else {
-        g.setColour(juce::Colours::white);
-        g.setFont(20.0f);
-        g.drawFittedText("Drop File to Load", getLocalBounds(), juce::Justification::centred, 1);
-    }
-}
-
-void WaveThumbnail::resized()
-{
-    // This method is where you should set the bounds of any child
-    // components that your component contains..
-
-}
-
-bool WaveThumbnail::isInterestedInFileDrag(const juce::StringArray& files) {
-    for (auto file : files) {
-        if (file.contains(".mp3") || file.contains(".wav")) {
-            return true;
-        }
-    }
-
-    return false;
-}
-
-void WaveThumbnail::filesDropped(const juce::StringArray& files, int x, int y) {
-    for (auto file : files) {
-        if (isInterestedInFileDrag(files)) {
-            auto myFile = std::make_unique<juce::File>(file);
-            fileName = myFile->getFileNameWithoutExtension();
-
-            audioProcessor.loadFile(file);
-        }
-    }
-    repaint();
-}
+/*
+  ==============================================================================
+
+    WaveThumbnail.cpp
+    Created: 9 Jul 2024 4:00:44pm
+    Author:  tmobr
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "WaveThumbnail.h"
+
+//==============================================================================
+WaveThumbnail::WaveThumbnail(SimpleSamplerAudioProcessor& p)
+    : audioProcessor(p), mVBlankAttachment(this, [this] { updatePlayheads(); })
+{
+    setOpaque(true);
+}
+
+WaveThumbnail::~WaveThumbnail()
+{
+}
+
+void WaveThumbnail::paint (juce::Graphics& g)
+{
+    if (mShownSample == nullptr || mShownSample->shown->getPeaks().isEmpty()) {
+        g.fillAll(juce::Colours::cadetblue.darker());
+        g.setColour(juce::Colours::white);
+        g.setFont(20.0f);
+        g.drawFittedText("Drop File to Load", getLocalBounds(), juce::Justification::centred, 1);
+        return;
+    }
+
+    const auto scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+
+    if (mWaveformImage.isNull()
+        || mWaveformImage.getWidth() != juce::roundToInt(getWidth() * scale)
+        || mWaveformImage.getHeight() != juce::roundToInt(getHeight() * scale)) {
+        renderWaveformImage(scale);
+    }
+
+    g.drawImage(mWaveformImage, getLocalBounds().toFloat());
+
+    // Each playhead fades with its voice's envelope.
+    for (const auto& playhead : mPlayheads) {
+        g.setColour(juce::Colours::white.withAlpha(playhead.alpha));
+        g.drawLine(playhead.x, 0, playhead.x, getHeight(), 2.0f);
+    }
+}
+
+void WaveThumbnail::renderWaveformImage(float scale) {
+    const auto width = juce::roundToInt(getWidth() * scale);
+    const auto height = juce::roundToInt(getHeight() * scale);
+
+    mWaveformImage = juce::Image(juce::Image::RGB, juce::jmax(1, width), juce::jmax(1, height), false);
+
+    juce::Graphics g(mWaveformImage);
+    g.fillAll(juce::Colours::cadetblue.darker());
+
+    const auto& peaks = mShownSample->shown->getPeaks();
+    const auto imageHeight = static_cast<float>(height);
+    const auto start = static_cast<double>(mShownSample->shown->getStartFrame());
+    const auto end = static_cast<double>(juce::jmin(mShownSample->shown->getEndFrame(), peaks.getNumSamples()));
+    const auto samplesPerPixel = (end - start) / juce::jmax(1, width);
+
+    // One min/max line and one RMS line per pixel, read from whichever
+    // pyramid level matches the current width. Only the part voices play is
+    // drawn, so trimmed silence takes up no room.
+    for (int x = 0; x < width; ++x) {
+        auto peak = peaks.getPeak(static_cast<juce::int64>(start + x * samplesPerPixel),
+                                  static_cast<juce::int64>(start + (x + 1) * samplesPerPixel));
+
+        g.setColour(juce::Colours::yellow);
+        g.drawVerticalLine(x, juce::jmap(peak.max, -1.0f, 1.0f, imageHeight, 0.0f), juce::jmap(peak.min, -1.0f, 1.0f, imageHeight, 0.0f) + 1.0f);
+
+        g.setColour(juce::Colours::orange);
+        g.drawVerticalLine(x, juce::jmap(peak.rms, -1.0f, 1.0f, imageHeight, 0.0f), juce::jmap(-peak.rms, -1.0f, 1.0f, imageHeight, 0.0f) + 1.0f);
+    }
+
+    g.addTransform(juce::AffineTransform::scale(scale));
+    g.setColour(juce::Colours::white);
+    g.setFont(15.0f);
+    auto bounds = getLocalBounds().reduced(10, 10);
+    g.drawFittedText(mShownSample->shown->getName(), bounds, juce::Justification::topRight, 1);
+}
+
+void WaveThumbnail::findPlayheads(std::vector<Playhead>& result) const {
+    result.clear();
+
+    if (mShownSample == nullptr || mShownSample->shown->getLengthInSamples() <= 0) {
+        return;
+    }
+
+    const auto now = juce::Time::getMillisecondCounterHiRes();
+    const auto start = static_cast<double>(mShownSample->shown->getStartFrame());
+    const auto end = static_cast<double>(mShownSample->shown->getEndFrame());
+
+    for (const auto& voice : mVoicePositions) {
+        if (voice.sample != mShownSample->shown.get()) {
+            continue;
+        }
+
+        // Never run on more than a tenth of a second past the last block, in
+        // case the audio thread has stalled.
+        auto elapsed = juce::jlimit(0.0, 0.1, (now - voice.time) / 1000.0);
+        auto position = voice.position + voice.framesPerSecond * elapsed;
+
+        if (position < end) {
+            result.push_back({ juce::roundToInt((position - start) / (end - start) * getWidth()),
+                               juce::jlimit(0.3f, 1.0f, voice.level) });
+        }
+    }
+}
+
+void WaveThumbnail::repaintPlayheads() {
+    for (const auto& playhead : mPlayheads) {
+        repaint(playhead.x - 2, 0, 4, getHeight());
+    }
+}
+
+void WaveThumbnail::updatePlayheads() {
+    auto loaded = audioProcessor.getLoadedSample();
+    audioProcessor.getPlayheads().readLatest(mVoicePositions);
+
+    if (loaded != mShownSample) {
+        mShownSample = loaded;
+        mWaveformImage = {};
+        findPlayheads(mPlayheads);
+        repaint();
+        return;
+    }
+
+    // Only the strips under the old and new playheads change; when nothing
+    // is playing this is a no-op and the component isn't redrawn at all.
+    findPlayheads(mNextPlayheads);
+
+    if (mNextPlayheads != mPlayheads) {
+        repaintPlayheads();
+        std::swap(mPlayheads, mNextPlayheads);
+        repaintPlayheads();
+    }
+}
+
+void WaveThumbnail::resized()
+{
+    mWaveformImage = {};
+}
+
+bool WaveThumbnail::isInterestedInFileDrag(const juce::StringArray& files) {
+    for (auto file : files) {
+        if (audioProcessor.canImport(juce::File(file))) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void WaveThumbnail::filesDropped(const juce::StringArray& files, int x, int y) {
+    audioProcessor.importFiles(files);
+}
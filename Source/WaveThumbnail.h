@@ -1,42 +1,62 @@
-/*
-  ==============================================================================
-
-    WaveThumbnail.h
-    Created: 9 Jul 2024 4:00:44pm
-    Author:  tmobr
-
-  ==============================================================================
-*/
-
-#pragma once
-
-#include <JuceHeader.h>
-#include "PluginProcessor.h"
-
-//==============================================================================
-/*
-*/
-class WaveThumbnail  : public juce::Component,
-                       public juce::FileDragAndDropTarget
-{
-public:
-    WaveThumbnail(SimpleSamplerAudioProcessor& p);
-    ~WaveThumbnail() override;
-
-    void paint (juce::Graphics&) override;
-    void resized() override;
-
-    bool isInterestedInFileDrag(const juce::StringArray& files) override;
-    void filesDropped(const juce::StringArray& files, int x, int y) override;
-
-private:
-
-    bool shouldBePainting{ false };
-    std::vector<float> audioPoints;
-
-    juce::String fileName{ "" };
-
-    SimpleSamplerAudioProcessor& audioProcessor;
-
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WaveThumbnail)
-};
+/*
+  ==============================================================================
+
+    WaveThumbnail.h
+    Created: 9 Jul 2024 4:00:44pm
+    Author:  tmobr
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+
+//==============================================================================
+/*
+*/
+class WaveThumbnail  : public juce::Component,
+                       public juce::FileDragAndDropTarget
+{
+public:
+    WaveThumbnail(SimpleSamplerAudioProcessor& p);
+    ~WaveThumbnail() override;
+
+    void paint (juce::Graphics&) override;
+    void resized() override;
+
+    bool isInterestedInFileDrag(const juce::StringArray& files) override;
+    void filesDropped(const juce::StringArray& files, int x, int y) override;
+
+private:
+    struct Playhead
+    {
+        int x;
+        float alpha;
+
+        bool operator== (const Playhead& other) const noexcept { return x == other.x && alpha == other.alpha; }
+    };
+
+    void updatePlayheads();
+    void renderWaveformImage(float scale);
+    void findPlayheads(std::vector<Playhead>& result) const;
+    void repaintPlayheads();
+
+    SimpleSamplerAudioProcessor& audioProcessor;
+
+    // The waveform and name only change when a new sample arrives or the
+    // component is resized, so they're drawn once into this image.
+    LoadedSample::Ptr mShownSample;
+    juce::Image mWaveformImage;
+
+    // One playhead per sounding voice, from the last block the audio thread
+    // published. Positions are extrapolated between blocks so large buffers
+    // don't make the playheads step.
+    std::vector<VoicePosition> mVoicePositions;
+    std::vector<Playhead> mPlayheads, mNextPlayheads;
+
+    juce::VBlankAttachment mVBlankAttachment;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WaveThumbnail)
+};
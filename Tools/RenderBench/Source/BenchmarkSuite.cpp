@@ -0,0 +1,264 @@
+/*
+  ==============================================================================
+
+    BenchmarkSuite.cpp
+    Created: 17 Oct 2026 10:52:37pm
+    Author:  tmobr
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "BenchmarkSuite.h"
+
+//==============================================================================
+BenchmarkSuite::BenchmarkSuite(SimpleSamplerAudioProcessor& processorToMeasure)
+    : mProcessor(processorToMeasure), mRenderer(processorToMeasure)
+{
+    mFormatManager.registerBasicFormats();
+}
+
+bool BenchmarkSuite::run(const juce::File& sample, const juce::Array<juce::File>& decodeFiles) {
+    mResults.clear();
+
+    if (!mRenderer.loadSample(sample)) {
+        return false;
+    }
+
+    auto loaded = mProcessor.getLoadedSample();
+
+    benchmarkProcessBlock();
+    benchmarkEnvelope(*loaded->keymap->getZones().getFirst());
+    benchmarkWaveform(loaded->shown->getPeaks());
+
+    for (const auto& file : decodeFiles) {
+        benchmarkDecode(file);
+    }
+
+    return true;
+}
+
+template <typename Function>
+BenchmarkSuite::Result BenchmarkSuite::measure(const juce::String& name, int iterations, Function&& function) {
+    std::vector<double> nanos;
+    nanos.reserve(static_cast<size_t>(iterations));
+
+    // One untimed pass to fault in pages and warm the caches.
+    function();
+
+    for (int i = 0; i < iterations; ++i) {
+        const auto start = juce::Time::getHighResolutionTicks();
+        function();
+        nanos.push_back(juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start) * 1.0e9);
+    }
+
+    std::sort(nanos.begin(), nanos.end());
+
+    Result result;
+    result.name = name;
+    result.iterations = iterations;
+    double total = 0.0;
+
+    for (auto n : nanos) {
+        total += n;
+    }
+
+    result.meanNanos = total / iterations;
+    result.medianNanos = nanos[nanos.size() / 2];
+    result.minNanos = nanos.front();
+
+    return result;
+}
+
+//==============================================================================
+void BenchmarkSuite::benchmarkProcessBlock() {
+    for (auto polyphony : { 8, 64, 256 }) {
+        for (auto blockSize : { 64, 256, 1024 }) {
+            OfflineRenderer::Settings settings;
+            settings.polyphony = polyphony;
+            settings.blockSize = blockSize;
+            settings.tailSeconds = 0.0;
+
+            // One-second notes arriving this often keep about that many sounding.
+            const auto sequence = OfflineRenderer::createNotePattern(4.0, static_cast<double>(polyphony), 1.0);
+            const auto rendered = mRenderer.render(sequence, settings);
+
+            Result result;
+            result.name = "processBlock/polyphony=" + juce::String(polyphony) + "/block=" + juce::String(blockSize);
+            result.iterations = rendered.numBlocks;
+            result.meanNanos = rendered.meanNanosPerBlock;
+            result.medianNanos = rendered.medianNanosPerBlock;
+            result.minNanos = rendered.bestNanosPerBlock;
+            result.throughput = rendered.realtimeFactor;
+            result.throughputUnit = "x realtime";
+
+            mResults.push_back(result);
+        }
+    }
+}
+
+void BenchmarkSuite::benchmarkEnvelope(const SampleSound& zone) {
+    constexpr int numVoices = 64, blockSize = 256;
+    constexpr double sampleRate = 48000.0;
+
+    VoiceBank bank;
+    bank.prepare(numVoices);
+    bank.setSampleRate(sampleRate);
+
+    juce::AudioBuffer<float> buffer(2, blockSize);
+
+    juce::ADSR::Parameters slow{ 0.5f, 0.5f, 0.8f, 1.0f }, fast{ 0.01f, 0.1f, 0.5f, 0.2f };
+    bank.setEnvelopeParameters(slow, 0);
+
+    auto startVoice = [&] (int voice) {
+        bank.start(voice, zone, nullptr, 0.5 + 0.01 * voice, 0.8f);
+    };
+
+    for (int voice = 0; voice < numVoices; ++voice) {
+        startVoice(voice);
+    }
+
+    // Finished voices are restarted straight away, so every block renders all of them.
+    auto renderBlock = [&] {
+        buffer.clear();
+        bank.render(buffer, 0, blockSize);
+
+        for (auto voice : bank.getFinishedVoices()) {
+            bank.remove(voice);
+            startVoice(voice);
+        }
+
+        bank.clearFinished();
+    };
+
+    auto fixed = measure("envelope/fixed/voices=64/block=256", 2000, renderBlock);
+
+    int block = 0;
+    auto ramping = measure("envelope/ramping/voices=64/block=256", 2000, [&] {
+        bank.setEnvelopeParameters(++block % 2 == 0 ? slow : fast, blockSize);
+        renderBlock();
+    });
+
+    for (auto* result : { &fixed, &ramping }) {
+        result->throughput = blockSize / sampleRate * 1.0e9 / result->medianNanos;
+        result->throughputUnit = "x realtime";
+        mResults.push_back(*result);
+    }
+}
+
+void BenchmarkSuite::benchmarkWaveform(const PeakPyramid& peaks) {
+    for (auto width : { 600, 1200, 2400 }) {
+        float sink = 0.0f;
+
+        auto result = measure("waveform/width=" + juce::String(width), 500, [&] {
+            const auto samplesPerPixel = static_cast<double>(peaks.getNumSamples()) / width;
+
+            for (int x = 0; x < width; ++x) {
+                const auto peak = peaks.getPeak(static_cast<juce::int64>(x * samplesPerPixel),
+                                                static_cast<juce::int64>((x + 1) * samplesPerPixel));
+                sink += peak.max - peak.min + peak.rms;
+            }
+        });
+
+        // Keeps the loop from being optimised away.
+        static volatile float keepSink;
+        keepSink = sink;
+
+        result.throughput = width * 1.0e9 / result.medianNanos;
+        result.throughputUnit = "pixels/s";
+        mResults.push_back(result);
+    }
+}
+
+// Mirrors the loader's in-memory path: a full decode, then the peaks.
+void BenchmarkSuite::benchmarkDecode(const juce::File& file) {
+    std::unique_ptr<juce::AudioFormatReader> reader(mFormatManager.createReaderFor(file));
+
+    if (reader == nullptr || reader->lengthInSamples <= 0 || reader->lengthInSamples > std::numeric_limits<int>::max()) {
+        return;
+    }
+
+    const auto length = static_cast<int>(reader->lengthInSamples);
+    juce::AudioBuffer<float> buffer(juce::jmin(2, static_cast<int>(reader->numChannels)), length);
+    PeakPyramid peaks;
+
+    auto result = measure("decode/" + file.getFileExtension().trimCharactersAtStart(".").toLowerCase() + "/" + file.getFileName(), 5, [&] {
+        // A fresh reader each time, so nothing is served from the last pass.
+        std::unique_ptr<juce::AudioFormatReader> source(mFormatManager.createReaderFor(file));
+        source->read(&buffer, 0, length, 0, true, true);
+
+        peaks.reset(length);
+        peaks.addSamples(buffer.getArrayOfReadPointers(), buffer.getNumChannels(), length);
+        peaks.finish();
+    });
+
+    result.throughput = static_cast<double>(length) / reader->sampleRate * 1.0e9 / result.medianNanos;
+    result.throughputUnit = "x realtime";
+    mResults.push_back(result);
+}
+
+//==============================================================================
+juce::var BenchmarkSuite::toJson() const {
+    auto* machine = new juce::DynamicObject();
+    machine->setProperty("cpu", juce::SystemStats::getCpuModel());
+    machine->setProperty("cores", juce::SystemStats::getNumCpus());
+    machine->setProperty("os", juce::SystemStats::getOperatingSystemName());
+
+    juce::Array<juce::var> results;
+
+    for (const auto& result : mResults) {
+        auto* entry = new juce::DynamicObject();
+        entry->setProperty("name", result.name);
+        entry->setProperty("iterations", result.iterations);
+        entry->setProperty("meanNanos", result.meanNanos);
+        entry->setProperty("medianNanos", result.medianNanos);
+        entry->setProperty("minNanos", result.minNanos);
+        entry->setProperty("throughput", result.throughput);
+        entry->setProperty("throughputUnit", result.throughputUnit);
+
+        results.add(juce::var(entry));
+    }
+
+    auto* root = new juce::DynamicObject();
+    root->setProperty("version", 1);
+    root->setProperty("time", juce::Time::getCurrentTime().toISO8601(true));
+    root->setProperty("machine", juce::var(machine));
+    root->setProperty("results", results);
+
+    return juce::var(root);
+}
+
+int BenchmarkSuite::compareWith(const juce::var& baseline, double tolerancePercent) const {
+    int numRegressions = 0;
+
+    for (const auto& result : mResults) {
+        const auto* baselineResults = baseline["results"].getArray();
+
+        if (baselineResults == nullptr) {
+            break;
+        }
+
+        for (const auto& entry : *baselineResults) {
+            if (entry["name"].toString() != result.name) {
+                continue;
+            }
+
+            const auto before = static_cast<double>(entry["medianNanos"]);
+
+            if (before <= 0.0) {
+                break;
+            }
+
+            const auto change = (result.medianNanos - before) / before * 100.0;
+            const auto regressed = change > tolerancePercent;
+
+            std::cout << (regressed ? "SLOWER  " : "        ")
+                      << result.name << ": " << juce::String(change, 1) << "%\n";
+
+            numRegressions += regressed ? 1 : 0;
+            break;
+        }
+    }
+
+    return numRegressions;
+}
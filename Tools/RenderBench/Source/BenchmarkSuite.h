@@ -0,0 +1,70 @@
+/*
+  ==============================================================================
+
+    BenchmarkSuite.h
+    Created: 17 Oct 2026 10:52:37pm
+    Author:  tmobr
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "OfflineRenderer.h"
+
+//==============================================================================
+/*
+    Times the sampler's hot paths in isolation and reports them as JSON, so
+    runs can be kept as baselines and compared later:
+
+    - processBlock across polyphony and block size
+    - the voice bank with a fixed and with a ramping envelope
+    - waveform decimation from the peak pyramid, as the thumbnail does it
+    - decoding throughput for each file given
+
+    Every case reports the median as well as the mean, since the median is
+    the figure that holds still between runs on a busy machine.
+*/
+class BenchmarkSuite
+{
+public:
+    struct Result
+    {
+        juce::String name;
+        int iterations = 0;
+        double meanNanos = 0.0, medianNanos = 0.0, minNanos = 0.0;
+        double throughput = 0.0;
+        juce::String throughputUnit;
+    };
+
+    explicit BenchmarkSuite(SimpleSamplerAudioProcessor& processorToMeasure);
+
+    // The sample drives the processBlock, envelope and waveform cases;
+    // decodeFiles only feed the decoding one.
+    bool run(const juce::File& sample, const juce::Array<juce::File>& decodeFiles);
+
+    const std::vector<Result>& getResults() const noexcept { return mResults; }
+    juce::var toJson() const;
+
+    // Prints how far each result's median moved from the baseline's, and
+    // returns how many got slower by more than the tolerance.
+    int compareWith(const juce::var& baseline, double tolerancePercent) const;
+
+private:
+    template <typename Function>
+    Result measure(const juce::String& name, int iterations, Function&& function);
+
+    void benchmarkProcessBlock();
+    void benchmarkEnvelope(const SampleSound& zone);
+    void benchmarkWaveform(const PeakPyramid& peaks);
+    void benchmarkDecode(const juce::File& file);
+
+    SimpleSamplerAudioProcessor& mProcessor;
+    OfflineRenderer mRenderer;
+    juce::AudioFormatManager mFormatManager;
+
+    std::vector<Result> mResults;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BenchmarkSuite)
+};
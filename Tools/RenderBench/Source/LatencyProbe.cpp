@@ -0,0 +1,214 @@
+/*
+  ==============================================================================
+
+    LatencyProbe.cpp
+    Created: 17 Oct 2026 11:38:20pm
+    Author:  tmobr
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "LatencyProbe.h"
+#include "OfflineRenderer.h"
+
+//==============================================================================
+LatencyProbe::LatencyProbe(SimpleSamplerAudioProcessor& processorToMeasure) : mProcessor(processorToMeasure)
+{
+}
+
+LatencyProbe::~LatencyProbe()
+{
+}
+
+bool LatencyProbe::loadSample(const juce::File& sample) {
+    OfflineRenderer renderer(mProcessor);
+
+    if (sample != juce::File()) {
+        return renderer.loadSample(sample);
+    }
+
+    // A second of a constant level: the first frame is already as loud as
+    // the rest, so the onset can't hide inside the sample's own fade-in.
+    constexpr double stepRate = 48000.0;
+    juce::AudioBuffer<float> step(1, static_cast<int>(stepRate));
+    juce::FloatVectorOperations::fill(step.getWritePointer(0), 0.5f, step.getNumSamples());
+
+    {
+        auto stream = mStepFile.getFile().createOutputStream();
+
+        if (stream == nullptr) {
+            return false;
+        }
+
+        juce::WavAudioFormat wav;
+        std::unique_ptr<juce::AudioFormatWriter> writer(wav.createWriterFor(stream.get(), stepRate, 1, 24, {}, 0));
+
+        if (writer == nullptr) {
+            return false;
+        }
+
+        stream.release(); // the writer owns it now
+        writer->writeFromAudioSampleBuffer(step, 0, step.getNumSamples());
+    }
+
+    return renderer.loadSample(mStepFile.getFile());
+}
+
+void LatencyProbe::setParameter(const juce::String& parameterID, float value) {
+    if (auto* parameter = mProcessor.getAPVTS().getParameter(parameterID)) {
+        parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+    }
+}
+
+std::vector<LatencyProbe::Trial> LatencyProbe::run(const Settings& settings) {
+    std::vector<Trial> trials;
+    juce::Random random(1);
+
+    // Full level from the first sample and gone as soon as the note ends.
+    setParameter("ATTACK", 0.0f);
+    setParameter("DECAY", 0.0f);
+    setParameter("SUSTAIN", 1.0f);
+    setParameter("RELEASE", 0.0f);
+    setParameter("QUALITY", static_cast<float>(settings.quality));
+    mProcessor.setNumRenderThreads(settings.renderThreads);
+
+    for (auto blockSize : settings.blockSizes) {
+        mProcessor.setPlayConfigDetails(0, 2, settings.sampleRate, blockSize);
+        mProcessor.prepareToPlay(settings.sampleRate, blockSize);
+
+        juce::Array<int> offsets{ 0, blockSize - 1 };
+
+        for (int attempt = 0; offsets.size() < juce::jmin(settings.offsetsPerBlockSize, blockSize) && attempt < 1000; ++attempt) {
+            offsets.addIfNotAlreadyThere(random.nextInt(blockSize));
+        }
+
+        offsets.sort();
+
+        for (auto offset : offsets) {
+            trials.push_back({ blockSize, offset, measure(blockSize, offset, settings) });
+        }
+
+        mProcessor.releaseResources();
+    }
+
+    return trials;
+}
+
+int LatencyProbe::measure(int blockSize, int offset, const Settings& settings) {
+    juce::AudioBuffer<float> buffer(2, blockSize);
+    juce::MidiBuffer midi;
+
+    // Whatever the last trial left ringing would be found instead of this note.
+    renderUntilSilent(blockSize, settings);
+
+    midi.addEvent(juce::MidiMessage::noteOn(1, rootNote, 1.0f), offset);
+
+    const auto maxBlocks = static_cast<int>(settings.sampleRate) / blockSize + 1;
+    int latency = -1;
+
+    for (int block = 0; block < maxBlocks && latency < 0; ++block) {
+        buffer.clear();
+        mProcessor.processBlock(buffer, midi);
+        midi.clear();
+
+        if (auto first = findFirstAbove(buffer, settings.threshold); first >= 0) {
+            latency = block * blockSize + first - offset;
+        }
+    }
+
+    midi.addEvent(juce::MidiMessage::noteOff(1, rootNote), 0);
+    buffer.clear();
+    mProcessor.processBlock(buffer, midi);
+
+    return latency;
+}
+
+void LatencyProbe::renderUntilSilent(int blockSize, const Settings& settings) {
+    juce::AudioBuffer<float> buffer(2, blockSize);
+    juce::MidiBuffer midi;
+
+    const auto maxBlocks = static_cast<int>(settings.sampleRate * 10.0) / blockSize + 1;
+
+    for (int block = 0; block < maxBlocks; ++block) {
+        buffer.clear();
+        mProcessor.processBlock(buffer, midi);
+
+        if (findFirstAbove(buffer, 0.0f) < 0) {
+            return;
+        }
+    }
+}
+
+int LatencyProbe::findFirstAbove(const juce::AudioBuffer<float>& buffer, float threshold) noexcept {
+    for (int i = 0; i < buffer.getNumSamples(); ++i) {
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel) {
+            if (std::abs(buffer.getSample(channel, i)) > threshold) {
+                return i;
+            }
+        }
+    }
+
+    return -1;
+}
+
+//==============================================================================
+LatencyProbe::Summary LatencyProbe::summarise(const std::vector<Trial>& trials) {
+    Summary summary;
+    std::vector<int> latencies;
+
+    for (const auto& trial : trials) {
+        ++summary.numTrials;
+
+        if (trial.latency < 0) {
+            ++summary.numMissed;
+        }
+        else {
+            latencies.push_back(trial.latency);
+        }
+    }
+
+    if (latencies.empty()) {
+        return summary;
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+
+    summary.minLatency = latencies.front();
+    summary.medianLatency = latencies[latencies.size() / 2];
+    summary.maxLatency = latencies.back();
+    summary.numOffsetErrors = static_cast<int>(std::count_if(latencies.begin(), latencies.end(), [&] (int latency) {
+        return latency != summary.minLatency;
+    }));
+
+    return summary;
+}
+
+juce::var LatencyProbe::toJson(const std::vector<Trial>& trials, const Summary& summary, double sampleRate) {
+    auto* root = new juce::DynamicObject();
+    juce::Array<juce::var> trialList;
+
+    for (const auto& trial : trials) {
+        auto* entry = new juce::DynamicObject();
+        entry->setProperty("blockSize", trial.blockSize);
+        entry->setProperty("offset", trial.offset);
+        entry->setProperty("latency", trial.latency);
+
+        trialList.add(juce::var(entry));
+    }
+
+    auto* totals = new juce::DynamicObject();
+    totals->setProperty("trials", summary.numTrials);
+    totals->setProperty("missed", summary.numMissed);
+    totals->setProperty("offsetErrors", summary.numOffsetErrors);
+    totals->setProperty("minLatency", summary.minLatency);
+    totals->setProperty("medianLatency", summary.medianLatency);
+    totals->setProperty("maxLatency", summary.maxLatency);
+    totals->setProperty("medianLatencyMs", summary.medianLatency * 1000.0 / sampleRate);
+
+    root->setProperty("sampleRate", sampleRate);
+    root->setProperty("summary", juce::var(totals));
+    root->setProperty("trials", trialList);
+
+    return juce::var(root);
+}
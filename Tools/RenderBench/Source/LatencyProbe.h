@@ -0,0 +1,79 @@
+/*
+  ==============================================================================
+
+    LatencyProbe.h
+    Created: 17 Oct 2026 11:38:20pm
+    Author:  tmobr
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+
+//==============================================================================
+/*
+    Checks that notes start on the sample they were sent for. Each trial sends
+    one note-on at a known offset into a block and finds the first output
+    sample above the threshold; the latency is how far that lands after the
+    note-on. Every block size and offset should give the same latency, so any
+    spread between trials is a note that started in the wrong place.
+
+    Envelopes are set to start at full level, and by default the sample is a
+    generated step that is non-zero from its first frame, so the latency
+    measured is the sampler's own.
+*/
+class LatencyProbe
+{
+public:
+    struct Settings
+    {
+        double sampleRate = 48000.0;
+        int renderThreads = 0;
+        ResamplingQuality quality = ResamplingQuality::cubic;
+        juce::Array<int> blockSizes { 1, 16, 64, 100, 256, 441, 512, 1024, 4096 };
+        int offsetsPerBlockSize = 8;    // always including the first and last sample of the block
+        float threshold = 1.0e-4f;      // -80 dB
+    };
+
+    struct Trial
+    {
+        int blockSize = 0;
+        int offset = 0;
+        int latency = -1;               // in samples; -1 if nothing was heard
+    };
+
+    struct Summary
+    {
+        int numTrials = 0, numMissed = 0;
+        int minLatency = 0, medianLatency = 0, maxLatency = 0;
+        int numOffsetErrors = 0;        // trials whose latency differs from the minimum
+    };
+
+    explicit LatencyProbe(SimpleSamplerAudioProcessor& processorToMeasure);
+    ~LatencyProbe();
+
+    // Loads the given sample, or the generated step if there is none.
+    bool loadSample(const juce::File& sample = {});
+
+    std::vector<Trial> run(const Settings& settings);
+
+    static Summary summarise(const std::vector<Trial>& trials);
+    static juce::var toJson(const std::vector<Trial>& trials, const Summary& summary, double sampleRate);
+
+private:
+    int measure(int blockSize, int offset, const Settings& settings);
+    void renderUntilSilent(int blockSize, const Settings& settings);
+    void setParameter(const juce::String& parameterID, float value);
+
+    static int findFirstAbove(const juce::AudioBuffer<float>& buffer, float threshold) noexcept;
+
+    static constexpr int rootNote = 60;
+
+    SimpleSamplerAudioProcessor& mProcessor;
+    juce::TemporaryFile mStepFile { ".wav" };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LatencyProbe)
+};
@@ -0,0 +1,197 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 17 Oct 2026 7:31:48pm
+    Author:  tmobr
+
+    Console front end for OfflineRenderer, BenchmarkSuite and LatencyProbe.
+    Builds against the plugin's Source folder, so the processor it measures
+    is exactly the one that ships.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "OfflineRenderer.h"
+#include "BenchmarkSuite.h"
+#include "LatencyProbe.h"
+
+//==============================================================================
+static void printUsage() {
+    std::cout << "usage: RenderBench --sample <file> [--midi <file.mid>] [--seconds <n>]\n"
+                 "                   [--rate <hz>] [--block <samples>] [--polyphony <n>]\n"
+                 "                   [--threads <n>] [--quality linear|cubic|sinc8|sinc32]\n"
+                 "                   [--out <file.wav>]\n"
+                 "       RenderBench --suite --sample <file> [--decode <file,file...>]\n"
+                 "                   [--json <file>] [--baseline <file.json>] [--tolerance <percent>]\n"
+                 "       RenderBench --latency [--sample <file>] [--rate <hz>] [--threads <n>]\n"
+                 "                   [--quality linear|cubic|sinc8|sinc32] [--json <file>] [--tolerance <samples>]\n";
+}
+
+static const juce::StringArray qualityNames{ "linear", "cubic", "sinc8", "sinc32" };
+
+static ResamplingQuality parseQuality(const juce::ArgumentList& args, ResamplingQuality fallback) {
+    const auto index = qualityNames.indexOf(args.getValueForOption("--quality"));
+    return index >= 0 ? static_cast<ResamplingQuality>(index) : fallback;
+}
+
+// Exits with 2 when a baseline is given and any case got slower than the
+// tolerance allows, so scripts can gate on it.
+static int runSuite(const juce::ArgumentList& args) {
+    SimpleSamplerAudioProcessor processor;
+    BenchmarkSuite suite(processor);
+
+    const auto sample = args.getExistingFileForOption("--sample");
+    juce::Array<juce::File> decodeFiles{ sample };
+
+    if (args.containsOption("--decode")) {
+        decodeFiles.clear();
+
+        for (const auto& path : juce::StringArray::fromTokens(args.getValueForOption("--decode"), ",", "")) {
+            decodeFiles.add(juce::File::getCurrentWorkingDirectory().getChildFile(path.trim()));
+        }
+    }
+
+    if (!suite.run(sample, decodeFiles)) {
+        std::cerr << "couldn't load " << args.getValueForOption("--sample") << "\n";
+        return 1;
+    }
+
+    const auto json = juce::JSON::toString(suite.toJson());
+
+    if (args.containsOption("--json")) {
+        juce::File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--json")).replaceWithText(json);
+    }
+    else {
+        std::cout << json << "\n";
+    }
+
+    if (args.containsOption("--baseline")) {
+        const auto baseline = juce::JSON::parse(args.getExistingFileForOption("--baseline"));
+        const auto tolerance = args.containsOption("--tolerance") ? args.getValueForOption("--tolerance").getDoubleValue() : 10.0;
+
+        if (suite.compareWith(baseline, tolerance) > 0) {
+            return 2;
+        }
+    }
+
+    return 0;
+}
+
+// Exits with 2 when any note went unheard or the latencies spread by more
+// than the tolerance, which is none by default: every note should start
+// exactly where it was sent.
+static int runLatency(const juce::ArgumentList& args) {
+    SimpleSamplerAudioProcessor processor;
+    LatencyProbe probe(processor);
+
+    LatencyProbe::Settings settings;
+    settings.renderThreads = juce::jmax(0, args.getValueForOption("--threads").getIntValue());
+    settings.quality = parseQuality(args, settings.quality);
+
+    if (args.containsOption("--rate")) {
+        settings.sampleRate = juce::jmax(1.0, args.getValueForOption("--rate").getDoubleValue());
+    }
+
+    const auto sample = args.containsOption("--sample") ? args.getExistingFileForOption("--sample") : juce::File();
+
+    if (!probe.loadSample(sample)) {
+        std::cerr << "couldn't load " << (sample == juce::File() ? juce::String("the test step") : sample.getFullPathName()) << "\n";
+        return 1;
+    }
+
+    const auto trials = probe.run(settings);
+    const auto summary = LatencyProbe::summarise(trials);
+
+    if (args.containsOption("--json")) {
+        juce::File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--json"))
+            .replaceWithText(juce::JSON::toString(LatencyProbe::toJson(trials, summary, settings.sampleRate)));
+    }
+
+    for (const auto& trial : trials) {
+        if (trial.latency != summary.minLatency) {
+            std::cout << "block " << trial.blockSize << ", offset " << trial.offset << ": "
+                      << (trial.latency < 0 ? juce::String("no output") : juce::String(trial.latency) + " samples") << "\n";
+        }
+    }
+
+    std::cout << "trials:          " << summary.numTrials << " over " << settings.blockSizes.size() << " block sizes\n"
+              << "missed notes:    " << summary.numMissed << "\n"
+              << "offset errors:   " << summary.numOffsetErrors << "\n"
+              << "latency:         " << summary.minLatency << " / " << summary.medianLatency << " / " << summary.maxLatency
+              << " samples (min / median / max)\n"
+              << "median latency:  " << juce::String(summary.medianLatency * 1000.0 / settings.sampleRate, 3) << " ms\n";
+
+    const auto tolerance = args.getValueForOption("--tolerance").getIntValue();
+
+    return summary.numMissed > 0 || summary.maxLatency - summary.minLatency > tolerance ? 2 : 0;
+}
+
+static int run(const juce::ArgumentList& args) {
+    if (args.containsOption("--latency")) {
+        return runLatency(args);
+    }
+
+    if (!args.containsOption("--sample")) {
+        printUsage();
+        return 1;
+    }
+
+    if (args.containsOption("--suite")) {
+        return runSuite(args);
+    }
+
+    OfflineRenderer::Settings settings;
+    settings.sampleRate = args.getValueForOption("--rate").getDoubleValue();
+    settings.blockSize = args.getValueForOption("--block").getIntValue();
+    settings.polyphony = args.getValueForOption("--polyphony").getIntValue();
+    settings.renderThreads = juce::jmax(0, args.getValueForOption("--threads").getIntValue());
+
+    settings.quality = parseQuality(args, settings.quality);
+
+    if (settings.sampleRate <= 0.0) settings.sampleRate = 48000.0;
+    if (settings.blockSize <= 0)    settings.blockSize = 512;
+    if (settings.polyphony <= 0)    settings.polyphony = 64;
+
+    if (args.containsOption("--out")) {
+        settings.outputFile = juce::File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--out"));
+    }
+
+    SimpleSamplerAudioProcessor processor;
+    OfflineRenderer renderer(processor);
+
+    if (!renderer.loadSample(args.getExistingFileForOption("--sample"))) {
+        std::cerr << "couldn't load " << args.getValueForOption("--sample") << "\n";
+        return 1;
+    }
+
+    auto sequence = args.containsOption("--midi")
+                  ? OfflineRenderer::readMidiFile(args.getExistingFileForOption("--midi"))
+                  : OfflineRenderer::createNotePattern(juce::jmax(1.0, args.getValueForOption("--seconds").getDoubleValue()), 8.0, 0.5);
+
+    auto result = renderer.render(sequence, settings);
+
+    std::cout << "blocks:          " << result.numBlocks << " x " << settings.blockSize << " @ " << settings.sampleRate << " Hz\n"
+              << "polyphony:       " << settings.polyphony << "\n"
+              << "render threads:  " << settings.renderThreads << "\n"
+              << "resampling:      " << qualityNames[static_cast<int>(settings.quality)] << "\n"
+              << "mean per block:  " << juce::String(result.meanNanosPerBlock, 0) << " ns\n"
+              << "median block:    " << juce::String(result.medianNanosPerBlock, 0) << " ns\n"
+              << "worst block:     " << juce::String(result.worstNanosPerBlock, 0) << " ns\n"
+              << "realtime factor: " << juce::String(result.realtimeFactor, 1) << "x\n";
+
+    if (result.wroteOutput) {
+        std::cout << "wrote:           " << settings.outputFile.getFullPathName() << "\n";
+    }
+
+    return 0;
+}
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    juce::ArgumentList args(argc, argv);
+
+    return juce::ConsoleApplication::invokeCatchingFailures([&] { return run(args); });
+}